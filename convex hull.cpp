@@ -1,342 +1,6873 @@
-#include<iostream>
-#include<time.h>
-using namespace std;
-
-#define size 11
-
-struct angle {
-
-    int x_diff;
-    int y_diff;
-
-};
-
-struct coord {
-
-    int x;
-    int y;
-    angle ang;
-
-};
-
-struct Node {
-
-    coord c;
-    Node* next;
-
-};
-
-int mod(int num) {
-
-    if( num < 0 ) {
-        return -num;
-    }
-
-    return num;
-
-}
-
-void pause() {
-
-    getchar();
-
-}
-
-/*stack implementation*/
-void addFirst(Node** head, coord num){
-
-    Node* node = new Node();
-    node->c.x = num.x;
-    node->c.y = num.y;
-    node->next = NULL;
-
-    if( *head == NULL ){
-        *head = node;
-    }
-    else{
-        node->next = *head;
-        *head = node;
-    }
-
-}
-
-void removeFirst(Node** head){
-
-    Node* temp = *head;
-    *head = (*head) -> next;
-
-    free(temp);
-
-}
-
-/*cross product of two 2-D vectors*/
-int crossProduct(coord num3, coord num2, coord num1){
-
-    coord v1;
-    v1.x = num2.x - num1.x;
-    v1.y = num2.y - num1.y;
-
-    coord v2;
-    v2.x = num3.x - num2.x;
-    v2.y = num3.y - num2.y;
-
-    int x = (v1.x)*(v2.y) - (v2.x)*(v1.y);
-    
-    if( x > 0 ){
-        return 1;
-    }
-    else{
-        return 0;
-    }
-
-}
-
-/*angle from +ve X w.r.t start point*/
-angle findAngle(coord start, coord curr) {
-
-    angle ans;
-    
-    ans.y_diff = curr.y - start.y;
-    ans.x_diff = curr.x - start.x;
-
-    return ans;
-
-}
-
-/*comparing two angles*/
-int larger(angle a1, angle a2) {
-
-    if( a1.x_diff * a2.y_diff == a2.x_diff * a1.y_diff ) {
-        
-        if( a1.y_diff > a2.y_diff || mod(a1.x_diff) > mod(a2.x_diff) ) {
-            return 1;
-        }
-        else {
-            return 2;
-        }
-
-    }
-    else if( a1.x_diff < 0 && a2.x_diff >= 0 ) {
-        return 1;
-    }
-    else if( a1.x_diff >= 0 && a2.x_diff < 0 ) {
-        return 2;
-    }
-    else if( a1.x_diff * a2.y_diff < a2.x_diff * a1.y_diff ) {
-        return 1;
-    }
-    else {
-        return 2;
-    }
-
-}
-
-/*finding the start point*/
-void findStart(coord* coordArr, int n) {
-
-    int start = 0;
-    for(int i=0; i<n; i++) {
-
-        coord curr = coordArr[i];
-        if( curr.y < coordArr[start].y ) {
-
-            start = i;
-        
-        }
-        else if( (curr.y == coordArr[start].y) && (curr.x < coordArr[start].x) ) {
-
-            start = i;
-
-        }
-
-    }
-    
-    coord temp = coordArr[0];
-    coordArr[0] = coordArr[start];
-    coordArr[start] = temp;
-
-}
-
-/*storing angle of coordinates*/
-void storeAngle(coord coordArr[]){
-
-    findStart(coordArr, size);
-
-    for(int i=0; i<size; i++){
-
-        angle temp = findAngle(coordArr[0], coordArr[i]);
-        coordArr[i].ang = temp;
-    
-    }
-
-}
-
-/*merging sorted parts of coordinates array*/
-void mergeSortedParts(coord* arr, int start, int end) {
-
-    int mid = (start + end) / 2;
-
-    int size1 = mid - start + 1;
-    int size2 = end - mid;
-
-    coord* arr1 = new coord[size1];
-    coord* arr2 = new coord[size2];
-
-    for(int i = 0 ; i<size1; i++) {
-        arr1[i] = arr[i + start];
-    }
-
-    for(int i = 0 ; i<size2 ; i++) {
-        arr2[i] = arr[i + mid + 1];
-    }
-
-    int i = 0, j = 0;
-
-    while(i < size1 && j < size2) {
-
-        if( larger(arr1[i].ang, arr2[j].ang) == 2) {
-
-            arr[start] = arr1[i];
-            start++;
-            i++;
-        
-        }
-        else {
-
-            arr[start] = arr2[j];
-            start++;
-            j++;
-
-        }
-
-    }
-
-    while(i < size1) {
-
-        arr[start] = arr1[i];
-        start++;
-        i++;
-
-    }
-
-    while(j < size2) {
-
-        arr[start] = arr2[j];
-        start++;
-        j++;
-
-    }
-
-    delete []arr1;
-    delete []arr2;
-
-}
-
-/*merge sorting on basis of angle and distance*/
-void mergeSort(coord* arr, int start, int end) {
-
-    // base case
-    if(start >= end) {
-        return;
-    }
-
-    int mid = (start + end) / 2;
-
-    mergeSort(arr, start, mid);
-    mergeSort(arr, mid + 1, end);
-
-    mergeSortedParts(arr, start, end);
-
-}
-
-/*function to print stack*/
-void printStack(Node* head) {
-
-    while(head != NULL) {
-
-        cout << "(" << head -> c.x << ", " << head -> c.y << ")" << endl;
-        head = head -> next;
-
-    }
-    cout << endl;
-
-}
-
-/*function to find hull of given points*/
-void findingHull(coord points[], Node** head){
-
-    addFirst(head, points[0]);
-    addFirst(head, points[1]);
-    printStack(*head);
-    pause();
-
-    for(int i=2; i<size; i++){
-
-        while(1){
-
-            if( (*head) -> next == NULL ){
-
-                addFirst(head, points[i]);
-                printStack(*head);
-                pause();
-                break;
-            
-            }
-            else{
-
-                if(!crossProduct(points[i], (*head) -> c, (*head) -> next -> c)){
-                    removeFirst(head);
-                    printStack(*head);
-                    pause();
-                }
-                else{
-                    addFirst(head, points[i]);
-                    printStack(*head);
-                    pause();
-                    break;
-                }
-            
-            }
-
-        }
-    }
-    
-}
-
-int main()
-{
-    coord coordArr[size] = {{3, 7}, {5, 4}, {9, 21}, {6, 14}, {0, 20}, {2, 0}, {-5, 10},
-    {10, 8}, {0, 2}, {0, 0}, {4, 0}};
-    
-    // coord coordArr[size];
-    // srand(time(NULL));
-    // for(int i=0; i<size; i++){
-    //     int n = rand()%10;
-    //     int m = rand()%10;
-    //     coordArr[i].x = n;
-    //     coordArr[i].y = m;
-    // }
-
-    storeAngle(coordArr);
-    mergeSort(coordArr, 1, size - 1);
-    
-    cout << "Given coordinates are:-" << endl << endl;
-    for(int i=0; i<size; i++){
-        cout << "(" << coordArr[i].x << ", " << coordArr[i].y << ")" << endl;
-    }
-
-    cout << endl;
-    Node* head = NULL;
-
-    cout << "Intermediate stacks of coordinates are:-" << endl << endl;
-    findingHull(coordArr, &head);
-
-    cout << "Coordinates of Convex Hull are:-" << endl << endl;
-    while(head != NULL){
-        cout << "(" << head -> c.x << ", " << head -> c.y << ")" << endl;
-        head = head -> next;
-    }
-
-    return 0;
-
-}
\ No newline at end of file
+#include<iostream>
+#include<vector>
+#include<string>
+#include<cstdio>
+#include<cstdlib>
+#include<climits>
+#include<cmath>
+#include<chrono>
+#include<random>
+#include<deque>
+#include<map>
+#include<list>
+#include<unordered_map>
+#include<memory>
+#include<new>
+#include<functional>
+#include<atomic>
+#include<mutex>
+#include<condition_variable>
+#include<thread>
+#include<future>
+#include<exception>
+#include<cstring>
+#include<cerrno>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<time.h>
+#include "convex hull.hpp"
+#if !defined(HULL_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HULL_X86_SIMD 1
+#include<immintrin.h>
+#endif
+#if !defined(HULL_NO_SIMD) && defined(__ARM_NEON)
+#define HULL_NEON_SIMD 1
+#include<arm_neon.h>
+#endif
+using namespace std;
+
+struct angle {
+
+    int x_diff;
+    int y_diff;
+
+};
+
+struct coord {
+
+    int x;
+    int y;
+    angle ang;
+
+};
+
+static_assert(sizeof(coord) == 4 * sizeof(int), "SIMD kernels write coord as four packed ints");
+
+/*pipeline stages the metrics time*/
+enum hullStage {
+
+    STAGE_CULL,
+    STAGE_ANGLES,       // findStart and storeAngle
+    STAGE_SORT,
+    STAGE_SCAN,
+    STAGE_CHAINS,       // monotone chain, sort included
+    STAGE_CHAN,
+    STAGE_QUICK,
+    STAGE_COUNT
+
+};
+
+#ifdef HULL_METRICS
+
+/*operation counts and stage times, kept per thread; build with -DHULL_METRICS to get them,
+  without it the hooks compile to nothing*/
+struct hullMetrics {
+
+    unsigned long long comparisons;     // larger() calls of the angle sorts
+    unsigned long long orientations;    // predicate<int>::orient calls
+    unsigned long long pushes;
+    unsigned long long pops;
+    unsigned long long culled;
+    unsigned long long scratchBytes;    // taken from the scratch arenas
+    unsigned long long stageNs[STAGE_COUNT];
+    unsigned long long stageTicks[STAGE_COUNT];    // cycle counter, 0 where there is none
+
+};
+
+/*every thread's metrics, plus what threads that already exited left behind*/
+struct metricsRegistry {
+
+    mutex lock;
+    vector<hullMetrics*> live;
+    hullMetrics retired;
+
+};
+
+metricsRegistry& registry() {
+
+    static metricsRegistry r;
+    return r;
+
+}
+
+void addMetrics(hullMetrics& to, const hullMetrics& from) {
+
+    to.comparisons += from.comparisons;
+    to.orientations += from.orientations;
+    to.pushes += from.pushes;
+    to.pops += from.pops;
+    to.culled += from.culled;
+    to.scratchBytes += from.scratchBytes;
+    for(int s=0; s<STAGE_COUNT; s++) {
+        to.stageNs[s] += from.stageNs[s];
+        to.stageTicks[s] += from.stageTicks[s];
+    }
+
+}
+
+/*one thread's metrics, registered while the thread lives*/
+struct metricsSlot {
+
+    hullMetrics m;
+
+    metricsSlot() : m() {
+
+        lock_guard<mutex> guard(registry().lock);
+        registry().live.push_back(&m);
+
+    }
+
+    ~metricsSlot() {
+
+        lock_guard<mutex> guard(registry().lock);
+        addMetrics(registry().retired, m);
+        vector<hullMetrics*>& live = registry().live;
+        for(size_t i=0; i<live.size(); i++) {
+            if( live[i] == &m ) {
+                live.erase(live.begin() + i);
+                break;
+            }
+        }
+
+    }
+
+};
+
+hullMetrics& threadMetrics() {
+
+    static thread_local metricsSlot slot;
+    return slot.m;
+
+}
+
+/*sum over all threads, pool workers included*/
+hullMetrics totalMetrics() {
+
+    lock_guard<mutex> guard(registry().lock);
+    hullMetrics sum = registry().retired;
+    for(hullMetrics* m : registry().live) {
+        addMetrics(sum, *m);
+    }
+    return sum;
+
+}
+
+void resetMetrics() {
+
+    lock_guard<mutex> guard(registry().lock);
+    registry().retired = hullMetrics();
+    for(hullMetrics* m : registry().live) {
+        *m = hullMetrics();
+    }
+
+}
+
+unsigned long long cycleTicks() {
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    unsigned long long t;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#else
+    return 0;
+#endif
+
+}
+
+/*adds the wall time and ticks of its lifetime to a stage*/
+class stageTimer {
+
+public:
+
+    explicit stageTimer(hullStage stage)
+        : stage(stage), start(chrono::steady_clock::now()), ticks(cycleTicks()) {}
+
+    ~stageTimer() {
+
+        hullMetrics& m = threadMetrics();
+        m.stageTicks[stage] += cycleTicks() - ticks;
+        m.stageNs[stage] += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    }
+
+private:
+
+    hullStage stage;
+    chrono::steady_clock::time_point start;
+    unsigned long long ticks;
+
+};
+
+/*a metrics summary, one line per counter and per stage that ran*/
+void printMetrics(FILE* f, const hullMetrics& m) {
+
+    const char* stages[STAGE_COUNT] = {"cull", "angles", "sort", "scan", "chains", "chan", "quick"};
+
+    fprintf(f, "comparisons    %llu\n", m.comparisons);
+    fprintf(f, "orientations   %llu\n", m.orientations);
+    fprintf(f, "pushes         %llu\n", m.pushes);
+    fprintf(f, "pops           %llu\n", m.pops);
+    fprintf(f, "culled         %llu\n", m.culled);
+    fprintf(f, "scratch bytes  %llu\n", m.scratchBytes);
+    for(int s=0; s<STAGE_COUNT; s++) {
+        if( m.stageNs[s] > 0 ) {
+            fprintf(f, "%-14s %.3f ms, %llu ticks\n", stages[s], m.stageNs[s] / 1e6, m.stageTicks[s]);
+        }
+    }
+
+}
+
+#define HULL_COUNT(counter, n) (threadMetrics().counter += (n))
+#define HULL_STAGE(stage) stageTimer stageTimer_##stage(stage)
+
+#else
+
+#define HULL_COUNT(counter, n) ((void)0)
+#define HULL_STAGE(stage) ((void)0)
+
+#endif
+
+int mod(int num) {
+
+    if( num < 0 ) {
+        return -num;
+    }
+
+    return num;
+
+}
+
+#ifndef HULL_QUIET
+void pauseTrace() {
+
+    getchar();
+
+}
+#endif
+
+/*stack implementation, one contiguous buffer reserved up front*/
+void push(vector<coord>& stack, coord num){
+
+    HULL_COUNT(pushes, 1);
+    stack.push_back(num);
+
+}
+
+void pop(vector<coord>& stack){
+
+    HULL_COUNT(pops, 1);
+    stack.pop_back();
+
+}
+
+/*the library predicates, with the int orientation test counted for the metrics*/
+template<typename T> struct predicate : hull::predicate<T> {};
+
+template<> struct predicate<int> : hull::predicate<int> {
+
+    static int orient(int ax, int ay, int bx, int by, int cx, int cy) {
+
+        HULL_COUNT(orientations, 1);
+        return hull::predicate<int>::orient(ax, ay, bx, by, cx, cy);
+
+    }
+
+};
+
+/*1 when num1 -> num2 -> num3 turns left*/
+int crossProduct(coord num3, coord num2, coord num1){
+
+    return predicate<int>::orient(num1.x, num1.y, num2.x, num2.y, num3.x, num3.y) > 0;
+
+}
+
+/*angle from +ve X w.r.t start point*/
+angle findAngle(coord start, coord curr) {
+
+    angle ans;
+    
+    ans.y_diff = curr.y - start.y;
+    ans.x_diff = curr.x - start.x;
+
+    return ans;
+
+}
+
+/*comparing two angles, 1 when a1 is larger; every offset lies in the upper half-plane with
+  y_diff == 0 only for x_diff >= 0, so the sign of the cross product orders them*/
+int larger(angle a1, angle a2) {
+
+    HULL_COUNT(comparisons, 1);
+    int c = predicate<int>::cross(a1.x_diff, a1.y_diff, a2.x_diff, a2.y_diff);
+
+    if( c == 0 ) {
+        
+        if( a1.y_diff > a2.y_diff || mod(a1.x_diff) > mod(a2.x_diff) ) {
+            return 1;
+        }
+        else {
+            return 2;
+        }
+
+    }
+
+    return c < 0 ? 1 : 2;
+
+}
+
+/*finding the start point, nothing to do for no points*/
+void findStart(coord* coordArr, size_t n) {
+
+    if( n == 0 ) {
+        return;
+    }
+
+    size_t start = 0;
+    for(size_t i=0; i<n; i++) {
+
+        coord curr = coordArr[i];
+        if( curr.y < coordArr[start].y ) {
+
+            start = i;
+        
+        }
+        else if( (curr.y == coordArr[start].y) && (curr.x < coordArr[start].x) ) {
+
+            start = i;
+
+        }
+
+    }
+    
+    coord temp = coordArr[0];
+    coordArr[0] = coordArr[start];
+    coordArr[start] = temp;
+
+}
+
+/*angles of coordinates around coordArr[0]*/
+void fillAngles(coord coordArr[], size_t n){
+
+    for(size_t i=0; i<n; i++){
+
+        angle temp = findAngle(coordArr[0], coordArr[i]);
+        coordArr[i].ang = temp;
+    
+    }
+
+}
+
+/*storing angle of coordinates*/
+void storeAngle(coord coordArr[], size_t n){
+
+    findStart(coordArr, n);
+    fillAngles(coordArr, n);
+
+}
+
+/*structure-of-arrays point storage*/
+struct pointSet {
+
+    vector<int> x;
+    vector<int> y;
+
+};
+
+/*first index of the lowest, then leftmost point*/
+size_t findStartScalar(const int* x, const int* y, size_t n) {
+
+    size_t start = 0;
+    for(size_t i=1; i<n; i++) {
+
+        if( y[i] < y[start] || (y[i] == y[start] && x[i] < x[start]) ) {
+            start = i;
+        }
+
+    }
+
+    return start;
+
+}
+
+/*writing coords with their offsets from (x0, y0) into out*/
+void storeAngleScalar(const int* x, const int* y, size_t n, int x0, int y0, coord* out) {
+
+    for(size_t i=0; i<n; i++) {
+
+        out[i].x = x[i];
+        out[i].y = y[i];
+        out[i].ang.x_diff = x[i] - x0;
+        out[i].ang.y_diff = y[i] - y0;
+
+    }
+
+}
+
+/*picking the lexicographic (y, x, index) minimum out of per-lane winners*/
+size_t reduceStartLanes(const int* lx, const int* ly, const int* li, int lanes) {
+
+    int best = 0;
+    for(int l=1; l<lanes; l++) {
+
+        if( ly[l] < ly[best] || (ly[l] == ly[best] && (lx[l] < lx[best] ||
+            (lx[l] == lx[best] && li[l] < li[best]))) ) {
+            best = l;
+        }
+
+    }
+
+    return (size_t)li[best];
+
+}
+
+/*index of the point farthest right of a -> b, the most negative (b - a) x (p - a); the SIMD
+  kernels expand it as b x p - a x p - C so every product is of two coordinates*/
+size_t farthestScalar(const int* x, const int* y, size_t n, int ax, int ay, int bx, int by) {
+
+    long long kx = (long long)bx - ax, ky = (long long)by - ay;
+    size_t best = 0;
+    long long low = 0;
+    for(size_t i=0; i<n; i++) {
+
+        long long d = kx * ((long long)y[i] - ay) - ky * ((long long)x[i] - ax);
+        if( i == 0 || d < low ) {
+            low = d;
+            best = i;
+        }
+
+    }
+
+    return best;
+
+}
+
+/*the constant C of the expanded cross product, (b - a) x a*/
+long long farthestBias(int ax, int ay, int bx, int by) {
+
+    return ((long long)bx - ax) * ay - ((long long)by - ay) * ax;
+
+}
+
+/*the fan of a hull with h >= 3 vertices for batched containment: vertices as interleaved
+  (x, y) so one 64-bit gather fetches both, and C of farthestBias for (v0, v[i]) and for
+  (v[i], v[i + 1])*/
+struct fanTable {
+
+    const int* xy;
+    const long long* fanBias;
+    const long long* edgeBias;
+    size_t h;
+
+};
+
+/*(b - a) x (p - a) through the expansion with bias = farthestBias(a, b)*/
+long long biasedOrient(long long ax, long long ay, long long bx, long long by, long long px, long long py,
+    long long bias) {
+
+    return bx * py - ax * py - by * px + ay * px - bias;
+
+}
+
+/*largest power of two not above the steps a fan search makes, 0 when there is one wedge*/
+size_t fanTopStep(size_t h) {
+
+    size_t top = 0;
+    for(size_t step=1; step<=h-3; step*=2) {
+        top = step;
+    }
+
+    return top;
+
+}
+
+/*whether each (x[i], y[i]) is in the fan's hull, boundary included: the wedge is found by
+  binary search without branches, then one edge test decides*/
+void insideFanScalar(const fanTable& fan, const int* x, const int* y, size_t n, unsigned char* inside) {
+
+    const int* v = fan.xy;
+    const long long ax = v[0], ay = v[1];
+    const size_t last = fan.h - 1, top = fanTopStep(fan.h);
+
+    for(size_t i=0; i<n; i++) {
+
+        long long px = x[i], py = y[i];
+        size_t lo = 1;
+        for(size_t step=top; step>0; step>>=1) {
+            size_t c = min(lo + step, last - 1);
+            lo = biasedOrient(ax, ay, v[2 * c], v[2 * c + 1], px, py, fan.fanBias[c]) >= 0 ? c : lo;
+        }
+
+        bool in = biasedOrient(ax, ay, v[2], v[3], px, py, fan.fanBias[1]) >= 0 &&
+            biasedOrient(ax, ay, v[2 * last], v[2 * last + 1], px, py, fan.fanBias[last]) <= 0 &&
+            biasedOrient(v[2 * lo], v[2 * lo + 1], v[2 * lo + 2], v[2 * lo + 3], px, py, fan.edgeBias[lo]) >= 0;
+        inside[i] = in;
+
+    }
+
+}
+
+/*per-lane keys of hashPoints: each stripe of eight points feeds lane j its point j xored with
+  hashSecret[j], and every hashBlockStripes stripes the lanes are scrambled with hashScramble*/
+const unsigned long long hashSecret[8] = {
+    0xbe4ba423396cfeb8ULL, 0x1cad21f72c81017cULL, 0xdb979083e96dd4deULL, 0x1f67b3b7a4a44072ULL,
+    0x78e5c0cc4ee679cbULL, 0x2172ffcc7dd05a82ULL, 0x8e2443f7744608b8ULL, 0x4c263a81e69035e0ULL};
+const unsigned long long hashScramble[8] = {
+    0xcb00c391bb52283cULL, 0xa32e531b8b65d088ULL, 0x4ef90da297486471ULL, 0xd8acdea946ef1938ULL,
+    0x3f349ce33f76faa8ULL, 0x1d4f0bc7c7bbdcf9ULL, 0x3159b4cd4be0518aULL, 0x647378d9c97e9fc8ULL};
+const size_t hashBlockStripes = 16;
+const unsigned long long hashPrime32 = 0x9e3779b1ULL;
+
+/*a point's x and y as one 64-bit word, the stored angle is not hashed*/
+unsigned long long hashWord(const coord& c) {
+
+    return (unsigned long long)(unsigned)c.x | (unsigned long long)(unsigned)c.y << 32;
+
+}
+
+/*one lane step: the word plus the 32 x 32-bit product of its keyed halves*/
+unsigned long long hashStep(unsigned long long acc, unsigned long long w, unsigned long long secret) {
+
+    unsigned long long k = w ^ secret;
+    return acc + w + (k & 0xffffffffULL) * (k >> 32);
+
+}
+
+unsigned long long hashMix(unsigned long long acc, unsigned long long scramble) {
+
+    acc ^= acc >> 47;
+    acc ^= scramble;
+    return acc * hashPrime32;
+
+}
+
+/*the lanes over `stripes` whole stripes of eight points from pts*/
+void hashStripesScalar(const coord* pts, size_t stripes, unsigned long long* acc) {
+
+    for(size_t s=0; s<stripes; s++) {
+
+        for(int j=0; j<8; j++) {
+            acc[j] = hashStep(acc[j], hashWord(pts[8 * s + j]), hashSecret[j]);
+        }
+
+        if( (s + 1) % hashBlockStripes == 0 ) {
+            for(int j=0; j<8; j++) {
+                acc[j] = hashMix(acc[j], hashScramble[j]);
+            }
+        }
+
+    }
+
+}
+
+#ifdef HULL_X86_SIMD
+
+__attribute__((target("avx2")))
+size_t findStartAvx2(const int* x, const int* y, size_t n) {
+
+    if( n < 16 ) {
+        return findStartScalar(x, y, n);
+    }
+
+    __m256i bx = _mm256_loadu_si256((const __m256i*)x);
+    __m256i by = _mm256_loadu_si256((const __m256i*)y);
+    __m256i bi = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i idx = bi;
+    const __m256i step = _mm256_set1_epi32(8);
+
+    size_t i = 8;
+    for(; i + 8 <= n; i += 8) {
+
+        idx = _mm256_add_epi32(idx, step);
+        __m256i vx = _mm256_loadu_si256((const __m256i*)(x + i));
+        __m256i vy = _mm256_loadu_si256((const __m256i*)(y + i));
+
+        __m256i less = _mm256_or_si256(_mm256_cmpgt_epi32(by, vy),
+            _mm256_and_si256(_mm256_cmpeq_epi32(by, vy), _mm256_cmpgt_epi32(bx, vx)));
+
+        bx = _mm256_blendv_epi8(bx, vx, less);
+        by = _mm256_blendv_epi8(by, vy, less);
+        bi = _mm256_blendv_epi8(bi, idx, less);
+
+    }
+
+    int lx[8], ly[8], li[8];
+    _mm256_storeu_si256((__m256i*)lx, bx);
+    _mm256_storeu_si256((__m256i*)ly, by);
+    _mm256_storeu_si256((__m256i*)li, bi);
+
+    size_t start = reduceStartLanes(lx, ly, li, 8);
+    for(; i<n; i++) {
+        if( y[i] < y[start] || (y[i] == y[start] && x[i] < x[start]) ) {
+            start = i;
+        }
+    }
+
+    return start;
+
+}
+
+__attribute__((target("avx2")))
+void storeAngleAvx2(const int* x, const int* y, size_t n, int x0, int y0, coord* out) {
+
+    const __m256i sx = _mm256_set1_epi32(x0);
+    const __m256i sy = _mm256_set1_epi32(y0);
+
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+
+        __m256i vx = _mm256_loadu_si256((const __m256i*)(x + i));
+        __m256i vy = _mm256_loadu_si256((const __m256i*)(y + i));
+        __m256i dx = _mm256_sub_epi32(vx, sx);
+        __m256i dy = _mm256_sub_epi32(vy, sy);
+
+        // 8x4 transpose into {x, y, x_diff, y_diff} records
+        __m256i t0 = _mm256_unpacklo_epi32(vx, vy);
+        __m256i t1 = _mm256_unpackhi_epi32(vx, vy);
+        __m256i t2 = _mm256_unpacklo_epi32(dx, dy);
+        __m256i t3 = _mm256_unpackhi_epi32(dx, dy);
+
+        __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+        __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+        __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+        __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+
+        __m256i* dst = (__m256i*)(out + i);
+        _mm256_storeu_si256(dst + 0, _mm256_permute2x128_si256(u0, u1, 0x20));
+        _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(u2, u3, 0x20));
+        _mm256_storeu_si256(dst + 2, _mm256_permute2x128_si256(u0, u1, 0x31));
+        _mm256_storeu_si256(dst + 3, _mm256_permute2x128_si256(u2, u3, 0x31));
+
+    }
+
+    storeAngleScalar(x + i, y + i, n - i, x0, y0, out + i);
+
+}
+
+__attribute__((target("avx2")))
+size_t farthestAvx2(const int* x, const int* y, size_t n, int ax, int ay, int bx, int by) {
+
+    if( n < 8 ) {
+        return farthestScalar(x, y, n, ax, ay, bx, by);
+    }
+
+    // _mm256_mul_epi32 multiplies the low signed halves of 64-bit lanes
+    const __m256i kax = _mm256_set1_epi64x(ax), kay = _mm256_set1_epi64x(ay);
+    const __m256i kbx = _mm256_set1_epi64x(bx), kby = _mm256_set1_epi64x(by);
+    const __m256i bias = _mm256_set1_epi64x(farthestBias(ax, ay, bx, by));
+    const __m256i step = _mm256_set1_epi64x(4);
+
+    __m256i best = _mm256_set1_epi64x(LLONG_MAX);
+    __m256i bi = _mm256_setzero_si256();
+    __m256i idx = _mm256_setr_epi64x(0, 1, 2, 3);
+
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+
+        __m256i px = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(x + i)));
+        __m256i py = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(y + i)));
+
+        __m256i d = _mm256_sub_epi64(_mm256_mul_epi32(kbx, py), _mm256_mul_epi32(kax, py));
+        d = _mm256_sub_epi64(d, _mm256_mul_epi32(kby, px));
+        d = _mm256_add_epi64(d, _mm256_mul_epi32(kay, px));
+        d = _mm256_sub_epi64(d, bias);
+
+        __m256i less = _mm256_cmpgt_epi64(best, d);
+        best = _mm256_blendv_epi8(best, d, less);
+        bi = _mm256_blendv_epi8(bi, idx, less);
+        idx = _mm256_add_epi64(idx, step);
+
+    }
+
+    long long lb[4], li[4];
+    _mm256_storeu_si256((__m256i*)lb, best);
+    _mm256_storeu_si256((__m256i*)li, bi);
+
+    // equal lanes go to the lower index, the first point farthestScalar would return
+    int lane = 0;
+    for(int l=1; l<4; l++) {
+        if( lb[l] < lb[lane] || (lb[l] == lb[lane] && li[l] < li[lane]) ) {
+            lane = l;
+        }
+    }
+
+    size_t far = (size_t)li[lane];
+    long long low = lb[lane];
+    long long kx = (long long)bx - ax, ky = (long long)by - ay;
+    for(; i<n; i++) {
+
+        long long d = kx * ((long long)y[i] - ay) - ky * ((long long)x[i] - ax);
+        if( d < low ) {
+            low = d;
+            far = i;
+        }
+
+    }
+
+    return far;
+
+}
+
+/*four fan orientations (b - a) x (p - a) at once, with a, b and the bias per lane; only the
+  low 32 bits of each coordinate lane are read*/
+__attribute__((target("avx2")))
+__m256i biasedOrientAvx2(__m256i ax, __m256i ay, __m256i bx, __m256i by, __m256i px, __m256i py, __m256i bias) {
+
+    __m256i d = _mm256_sub_epi64(_mm256_mul_epi32(bx, py), _mm256_mul_epi32(ax, py));
+    d = _mm256_sub_epi64(d, _mm256_mul_epi32(by, px));
+    d = _mm256_add_epi64(d, _mm256_mul_epi32(ay, px));
+    return _mm256_sub_epi64(d, bias);
+
+}
+
+/*one binary lifting step of insideFanAvx2 for four points*/
+__attribute__((target("avx2")))
+__m256i fanStepAvx2(const fanTable& fan, __m256i ax, __m256i ay, __m256i lo, __m256i step,
+    __m256i beforeLast, __m256i px, __m256i py) {
+
+    __m256i c = _mm256_add_epi64(lo, step);
+    c = _mm256_blendv_epi8(c, beforeLast, _mm256_cmpgt_epi64(c, beforeLast));
+    __m256i b = _mm256_i64gather_epi64((const long long*)fan.xy, c, 8);
+    __m256i d = biasedOrientAvx2(ax, ay, b, _mm256_srli_epi64(b, 32), px, py,
+        _mm256_i64gather_epi64(fan.fanBias, c, 8));
+    return _mm256_blendv_epi8(c, lo, _mm256_cmpgt_epi64(_mm256_setzero_si256(), d));
+
+}
+
+/*the final wedge and edge test of insideFanAvx2 for four points, one inside flag per point*/
+__attribute__((target("avx2")))
+void fanFinishAvx2(const fanTable& fan, __m256i lo, __m256i first, __m256i end,
+    __m256i px, __m256i py, unsigned char* inside) {
+
+    const __m256i zero = _mm256_setzero_si256();
+    const long long* pairs = (const long long*)fan.xy;
+    __m256i a = _mm256_i64gather_epi64(pairs, lo, 8);
+    __m256i b = _mm256_i64gather_epi64(pairs, _mm256_add_epi64(lo, _mm256_set1_epi64x(1)), 8);
+    __m256i edge = biasedOrientAvx2(a, _mm256_srli_epi64(a, 32), b, _mm256_srli_epi64(b, 32), px, py,
+        _mm256_i64gather_epi64(fan.edgeBias, lo, 8));
+
+    __m256i out = _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi64(zero, first), _mm256_cmpgt_epi64(end, zero)),
+        _mm256_cmpgt_epi64(zero, edge));
+    int mask = _mm256_movemask_pd(_mm256_castsi256_pd(out));
+    for(int l=0; l<4; l++) {
+        inside[l] = !((mask >> l) & 1);
+    }
+
+}
+
+/*insideFanScalar for eight points per step: two independent groups of four, so one group's
+  gathers overlap the other's*/
+__attribute__((target("avx2")))
+void insideFanAvx2(const fanTable& fan, const int* x, const int* y, size_t n, unsigned char* inside) {
+
+    const int* v = fan.xy;
+    const __m256i ax = _mm256_set1_epi64x(v[0]), ay = _mm256_set1_epi64x(v[1]);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i beforeLast = _mm256_set1_epi64x((long long)fan.h - 2);
+    const size_t last = fan.h - 1, top = fanTopStep(fan.h);
+
+    const __m256i x1 = _mm256_set1_epi64x(v[2]), y1 = _mm256_set1_epi64x(v[3]);
+    const __m256i b1 = _mm256_set1_epi64x(fan.fanBias[1]);
+    const __m256i xl = _mm256_set1_epi64x(v[2 * last]), yl = _mm256_set1_epi64x(v[2 * last + 1]);
+    const __m256i bl = _mm256_set1_epi64x(fan.fanBias[last]);
+
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+
+        __m256i px0 = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(x + i)));
+        __m256i py0 = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(y + i)));
+        __m256i px1 = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(x + i + 4)));
+        __m256i py1 = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(y + i + 4)));
+
+        __m256i lo0 = one, lo1 = one;
+        for(size_t step=top; step>0; step>>=1) {
+
+            __m256i s = _mm256_set1_epi64x((long long)step);
+            lo0 = fanStepAvx2(fan, ax, ay, lo0, s, beforeLast, px0, py0);
+            lo1 = fanStepAvx2(fan, ax, ay, lo1, s, beforeLast, px1, py1);
+
+        }
+
+        fanFinishAvx2(fan, lo0, biasedOrientAvx2(ax, ay, x1, y1, px0, py0, b1),
+            biasedOrientAvx2(ax, ay, xl, yl, px0, py0, bl), px0, py0, inside + i);
+        fanFinishAvx2(fan, lo1, biasedOrientAvx2(ax, ay, x1, y1, px1, py1, b1),
+            biasedOrientAvx2(ax, ay, xl, yl, px1, py1, bl), px1, py1, inside + i + 4);
+
+    }
+
+    insideFanScalar(fan, x + i, y + i, n - i, inside + i);
+
+}
+
+/*x, y words of four consecutive coords in order, their angles dropped*/
+__attribute__((target("avx2")))
+__m256i hashWordsAvx2(const coord* p) {
+
+    __m256i a = _mm256_loadu_si256((const __m256i*)p);
+    __m256i b = _mm256_loadu_si256((const __m256i*)(p + 2));
+    return _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xd8);
+
+}
+
+__attribute__((target("avx2")))
+__m256i hashStepAvx2(__m256i acc, __m256i w, __m256i secret) {
+
+    __m256i k = _mm256_xor_si256(w, secret);
+    return _mm256_add_epi64(acc, _mm256_add_epi64(w, _mm256_mul_epu32(k, _mm256_srli_epi64(k, 32))));
+
+}
+
+/*hashMix with the 64 x 32-bit product split into two 32 x 32-bit ones*/
+__attribute__((target("avx2")))
+__m256i hashMixAvx2(__m256i acc, __m256i scramble) {
+
+    const __m256i prime = _mm256_set1_epi64x((long long)hashPrime32);
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+    acc = _mm256_xor_si256(acc, scramble);
+    __m256i lo = _mm256_mul_epu32(acc, prime);
+    __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(acc, 32), prime);
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+
+}
+
+__attribute__((target("avx2")))
+void hashStripesAvx2(const coord* pts, size_t stripes, unsigned long long* acc) {
+
+    const __m256i s0 = _mm256_loadu_si256((const __m256i*)hashSecret);
+    const __m256i s1 = _mm256_loadu_si256((const __m256i*)(hashSecret + 4));
+    const __m256i m0 = _mm256_loadu_si256((const __m256i*)hashScramble);
+    const __m256i m1 = _mm256_loadu_si256((const __m256i*)(hashScramble + 4));
+    __m256i a0 = _mm256_loadu_si256((const __m256i*)acc);
+    __m256i a1 = _mm256_loadu_si256((const __m256i*)(acc + 4));
+
+    for(size_t s=0; s<stripes; s++) {
+
+        const coord* p = pts + 8 * s;
+        a0 = hashStepAvx2(a0, hashWordsAvx2(p), s0);
+        a1 = hashStepAvx2(a1, hashWordsAvx2(p + 4), s1);
+
+        if( (s + 1) % hashBlockStripes == 0 ) {
+            a0 = hashMixAvx2(a0, m0);
+            a1 = hashMixAvx2(a1, m1);
+        }
+
+    }
+
+    _mm256_storeu_si256((__m256i*)acc, a0);
+    _mm256_storeu_si256((__m256i*)(acc + 4), a1);
+
+}
+
+__attribute__((target("avx512f")))
+size_t findStartAvx512(const int* x, const int* y, size_t n) {
+
+    if( n < 32 ) {
+        return findStartScalar(x, y, n);
+    }
+
+    __m512i bx = _mm512_loadu_si512(x);
+    __m512i by = _mm512_loadu_si512(y);
+    __m512i bi = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i idx = bi;
+    const __m512i step = _mm512_set1_epi32(16);
+
+    size_t i = 16;
+    for(; i + 16 <= n; i += 16) {
+
+        idx = _mm512_add_epi32(idx, step);
+        __m512i vx = _mm512_loadu_si512(x + i);
+        __m512i vy = _mm512_loadu_si512(y + i);
+
+        __mmask16 less = _mm512_cmplt_epi32_mask(vy, by) |
+            (_mm512_cmpeq_epi32_mask(vy, by) & _mm512_cmplt_epi32_mask(vx, bx));
+
+        bx = _mm512_mask_blend_epi32(less, bx, vx);
+        by = _mm512_mask_blend_epi32(less, by, vy);
+        bi = _mm512_mask_blend_epi32(less, bi, idx);
+
+    }
+
+    int lx[16], ly[16], li[16];
+    _mm512_storeu_si512(lx, bx);
+    _mm512_storeu_si512(ly, by);
+    _mm512_storeu_si512(li, bi);
+
+    size_t start = reduceStartLanes(lx, ly, li, 16);
+    for(; i<n; i++) {
+        if( y[i] < y[start] || (y[i] == y[start] && x[i] < x[start]) ) {
+            start = i;
+        }
+    }
+
+    return start;
+
+}
+
+// GCC 12 flags its own _mm512_undefined_epi32 inside the unpack/shuffle/extend intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+__attribute__((target("avx512f")))
+void storeAngleAvx512(const int* x, const int* y, size_t n, int x0, int y0, coord* out) {
+
+    const __m512i sx = _mm512_set1_epi32(x0);
+    const __m512i sy = _mm512_set1_epi32(y0);
+
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16) {
+
+        __m512i vx = _mm512_loadu_si512(x + i);
+        __m512i vy = _mm512_loadu_si512(y + i);
+        __m512i dx = _mm512_sub_epi32(vx, sx);
+        __m512i dy = _mm512_sub_epi32(vy, sy);
+
+        // u<k> holds point 4 * lane + k in each 128-bit lane
+        __m512i t0 = _mm512_unpacklo_epi32(vx, vy);
+        __m512i t1 = _mm512_unpackhi_epi32(vx, vy);
+        __m512i t2 = _mm512_unpacklo_epi32(dx, dy);
+        __m512i t3 = _mm512_unpackhi_epi32(dx, dy);
+
+        __m512i u0 = _mm512_unpacklo_epi64(t0, t2);
+        __m512i u1 = _mm512_unpackhi_epi64(t0, t2);
+        __m512i u2 = _mm512_unpacklo_epi64(t1, t3);
+        __m512i u3 = _mm512_unpackhi_epi64(t1, t3);
+
+        // 4x4 transpose of 128-bit lanes
+        __m512i v0 = _mm512_shuffle_i32x4(u0, u1, 0x44);
+        __m512i v1 = _mm512_shuffle_i32x4(u2, u3, 0x44);
+        __m512i v2 = _mm512_shuffle_i32x4(u0, u1, 0xEE);
+        __m512i v3 = _mm512_shuffle_i32x4(u2, u3, 0xEE);
+
+        int* dst = (int*)(out + i);
+        _mm512_storeu_si512(dst + 0, _mm512_shuffle_i32x4(v0, v1, 0x88));
+        _mm512_storeu_si512(dst + 16, _mm512_shuffle_i32x4(v0, v1, 0xDD));
+        _mm512_storeu_si512(dst + 32, _mm512_shuffle_i32x4(v2, v3, 0x88));
+        _mm512_storeu_si512(dst + 48, _mm512_shuffle_i32x4(v2, v3, 0xDD));
+
+    }
+
+    storeAngleScalar(x + i, y + i, n - i, x0, y0, out + i);
+
+}
+
+__attribute__((target("avx512f")))
+size_t farthestAvx512(const int* x, const int* y, size_t n, int ax, int ay, int bx, int by) {
+
+    if( n < 16 ) {
+        return farthestScalar(x, y, n, ax, ay, bx, by);
+    }
+
+    const __m512i kax = _mm512_set1_epi64(ax), kay = _mm512_set1_epi64(ay);
+    const __m512i kbx = _mm512_set1_epi64(bx), kby = _mm512_set1_epi64(by);
+    const __m512i bias = _mm512_set1_epi64(farthestBias(ax, ay, bx, by));
+    const __m512i step = _mm512_set1_epi64(8);
+
+    __m512i best = _mm512_set1_epi64(LLONG_MAX);
+    __m512i bi = _mm512_setzero_si512();
+    __m512i idx = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+
+        __m512i px = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*)(x + i)));
+        __m512i py = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*)(y + i)));
+
+        __m512i d = _mm512_sub_epi64(_mm512_mul_epi32(kbx, py), _mm512_mul_epi32(kax, py));
+        d = _mm512_sub_epi64(d, _mm512_mul_epi32(kby, px));
+        d = _mm512_add_epi64(d, _mm512_mul_epi32(kay, px));
+        d = _mm512_sub_epi64(d, bias);
+
+        __mmask8 less = _mm512_cmplt_epi64_mask(d, best);
+        best = _mm512_mask_blend_epi64(less, best, d);
+        bi = _mm512_mask_blend_epi64(less, bi, idx);
+        idx = _mm512_add_epi64(idx, step);
+
+    }
+
+    long long lb[8], li[8];
+    _mm512_storeu_si512(lb, best);
+    _mm512_storeu_si512(li, bi);
+
+    int lane = 0;
+    for(int l=1; l<8; l++) {
+        if( lb[l] < lb[lane] || (lb[l] == lb[lane] && li[l] < li[lane]) ) {
+            lane = l;
+        }
+    }
+
+    size_t far = (size_t)li[lane];
+    long long low = lb[lane];
+    long long kx = (long long)bx - ax, ky = (long long)by - ay;
+    for(; i<n; i++) {
+
+        long long d = kx * ((long long)y[i] - ay) - ky * ((long long)x[i] - ax);
+        if( d < low ) {
+            low = d;
+            far = i;
+        }
+
+    }
+
+    return far;
+
+}
+
+/*biasedOrientAvx2 on eight lanes*/
+__attribute__((target("avx512f")))
+__m512i biasedOrientAvx512(__m512i ax, __m512i ay, __m512i bx, __m512i by, __m512i px, __m512i py, __m512i bias) {
+
+    __m512i d = _mm512_sub_epi64(_mm512_mul_epi32(bx, py), _mm512_mul_epi32(ax, py));
+    d = _mm512_sub_epi64(d, _mm512_mul_epi32(by, px));
+    d = _mm512_add_epi64(d, _mm512_mul_epi32(ay, px));
+    return _mm512_sub_epi64(d, bias);
+
+}
+
+/*one binary lifting step of insideFanAvx512 for eight points*/
+__attribute__((target("avx512f")))
+__m512i fanStepAvx512(const fanTable& fan, __m512i ax, __m512i ay, __m512i lo, __m512i step,
+    __m512i beforeLast, __m512i px, __m512i py) {
+
+    __m512i c = _mm512_min_epi64(_mm512_add_epi64(lo, step), beforeLast);
+    __m512i b = _mm512_i64gather_epi64(c, fan.xy, 8);
+    __m512i d = biasedOrientAvx512(ax, ay, b, _mm512_srli_epi64(b, 32), px, py,
+        _mm512_i64gather_epi64(c, fan.fanBias, 8));
+    return _mm512_mask_blend_epi64(_mm512_cmpge_epi64_mask(d, _mm512_setzero_si512()), lo, c);
+
+}
+
+/*the final wedge and edge test of insideFanAvx512 for eight points, one inside flag per point*/
+__attribute__((target("avx512f")))
+void fanFinishAvx512(const fanTable& fan, __m512i lo, __m512i first, __m512i end,
+    __m512i px, __m512i py, unsigned char* inside) {
+
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i a = _mm512_i64gather_epi64(lo, fan.xy, 8);
+    __m512i b = _mm512_i64gather_epi64(_mm512_add_epi64(lo, _mm512_set1_epi64(1)), fan.xy, 8);
+    __m512i edge = biasedOrientAvx512(a, _mm512_srli_epi64(a, 32), b, _mm512_srli_epi64(b, 32), px, py,
+        _mm512_i64gather_epi64(lo, fan.edgeBias, 8));
+
+    __mmask8 in = _mm512_cmpge_epi64_mask(first, zero) & _mm512_cmple_epi64_mask(end, zero) &
+        _mm512_cmpge_epi64_mask(edge, zero);
+    for(int l=0; l<8; l++) {
+        inside[l] = (in >> l) & 1;
+    }
+
+}
+
+/*insideFanScalar for sixteen points per step, as two independent groups of eight*/
+__attribute__((target("avx512f")))
+void insideFanAvx512(const fanTable& fan, const int* x, const int* y, size_t n, unsigned char* inside) {
+
+    const int* v = fan.xy;
+    const __m512i ax = _mm512_set1_epi64(v[0]), ay = _mm512_set1_epi64(v[1]);
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i beforeLast = _mm512_set1_epi64((long long)fan.h - 2);
+    const size_t last = fan.h - 1, top = fanTopStep(fan.h);
+
+    const __m512i x1 = _mm512_set1_epi64(v[2]), y1 = _mm512_set1_epi64(v[3]);
+    const __m512i b1 = _mm512_set1_epi64(fan.fanBias[1]);
+    const __m512i xl = _mm512_set1_epi64(v[2 * last]), yl = _mm512_set1_epi64(v[2 * last + 1]);
+    const __m512i bl = _mm512_set1_epi64(fan.fanBias[last]);
+
+    size_t i = 0;
+    for(; i + 16 <= n; i += 16) {
+
+        __m512i px0 = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*)(x + i)));
+        __m512i py0 = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*)(y + i)));
+        __m512i px1 = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*)(x + i + 8)));
+        __m512i py1 = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*)(y + i + 8)));
+
+        __m512i lo0 = one, lo1 = one;
+        for(size_t step=top; step>0; step>>=1) {
+
+            __m512i s = _mm512_set1_epi64((long long)step);
+            lo0 = fanStepAvx512(fan, ax, ay, lo0, s, beforeLast, px0, py0);
+            lo1 = fanStepAvx512(fan, ax, ay, lo1, s, beforeLast, px1, py1);
+
+        }
+
+        fanFinishAvx512(fan, lo0, biasedOrientAvx512(ax, ay, x1, y1, px0, py0, b1),
+            biasedOrientAvx512(ax, ay, xl, yl, px0, py0, bl), px0, py0, inside + i);
+        fanFinishAvx512(fan, lo1, biasedOrientAvx512(ax, ay, x1, y1, px1, py1, b1),
+            biasedOrientAvx512(ax, ay, xl, yl, px1, py1, bl), px1, py1, inside + i + 8);
+
+    }
+
+    insideFanScalar(fan, x + i, y + i, n - i, inside + i);
+
+}
+
+/*hashStripesAvx2 with all eight lanes in one register*/
+__attribute__((target("avx512f")))
+void hashStripesAvx512(const coord* pts, size_t stripes, unsigned long long* acc) {
+
+    const __m512i words = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+    const __m512i prime = _mm512_set1_epi64((long long)hashPrime32);
+    const __m512i secret = _mm512_loadu_si512(hashSecret);
+    const __m512i scramble = _mm512_loadu_si512(hashScramble);
+    __m512i a = _mm512_loadu_si512(acc);
+
+    for(size_t s=0; s<stripes; s++) {
+
+        const coord* p = pts + 8 * s;
+        __m512i w = _mm512_permutex2var_epi64(_mm512_loadu_si512(p), words, _mm512_loadu_si512(p + 4));
+        __m512i k = _mm512_xor_si512(w, secret);
+        a = _mm512_add_epi64(a, _mm512_add_epi64(w, _mm512_mul_epu32(k, _mm512_srli_epi64(k, 32))));
+
+        if( (s + 1) % hashBlockStripes == 0 ) {
+            a = _mm512_xor_si512(a, _mm512_srli_epi64(a, 47));
+            a = _mm512_xor_si512(a, scramble);
+            __m512i lo = _mm512_mul_epu32(a, prime);
+            __m512i hi = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), prime);
+            a = _mm512_add_epi64(lo, _mm512_slli_epi64(hi, 32));
+        }
+
+    }
+
+    _mm512_storeu_si512(acc, a);
+
+}
+#pragma GCC diagnostic pop
+
+#endif
+
+#ifdef HULL_NEON_SIMD
+
+size_t findStartNeon(const int* x, const int* y, size_t n) {
+
+    if( n < 8 ) {
+        return findStartScalar(x, y, n);
+    }
+
+    int32x4_t bx = vld1q_s32(x);
+    int32x4_t by = vld1q_s32(y);
+    const int lanes[4] = {0, 1, 2, 3};
+    int32x4_t bi = vld1q_s32(lanes);
+    int32x4_t idx = bi;
+    const int32x4_t step = vdupq_n_s32(4);
+
+    size_t i = 4;
+    for(; i + 4 <= n; i += 4) {
+
+        idx = vaddq_s32(idx, step);
+        int32x4_t vx = vld1q_s32(x + i);
+        int32x4_t vy = vld1q_s32(y + i);
+
+        uint32x4_t less = vorrq_u32(vcltq_s32(vy, by), vandq_u32(vceqq_s32(vy, by), vcltq_s32(vx, bx)));
+
+        bx = vbslq_s32(less, vx, bx);
+        by = vbslq_s32(less, vy, by);
+        bi = vbslq_s32(less, idx, bi);
+
+    }
+
+    int lx[4], ly[4], li[4];
+    vst1q_s32(lx, bx);
+    vst1q_s32(ly, by);
+    vst1q_s32(li, bi);
+
+    size_t start = reduceStartLanes(lx, ly, li, 4);
+    for(; i<n; i++) {
+        if( y[i] < y[start] || (y[i] == y[start] && x[i] < x[start]) ) {
+            start = i;
+        }
+    }
+
+    return start;
+
+}
+
+void storeAngleNeon(const int* x, const int* y, size_t n, int x0, int y0, coord* out) {
+
+    const int32x4_t sx = vdupq_n_s32(x0);
+    const int32x4_t sy = vdupq_n_s32(y0);
+
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+
+        int32x4x4_t rec;
+        rec.val[0] = vld1q_s32(x + i);
+        rec.val[1] = vld1q_s32(y + i);
+        rec.val[2] = vsubq_s32(rec.val[0], sx);
+        rec.val[3] = vsubq_s32(rec.val[1], sy);
+        vst4q_s32((int*)(out + i), rec);
+
+    }
+
+    storeAngleScalar(x + i, y + i, n - i, x0, y0, out + i);
+
+}
+
+#ifdef __aarch64__
+size_t farthestNeon(const int* x, const int* y, size_t n, int ax, int ay, int bx, int by) {
+
+    if( n < 8 ) {
+        return farthestScalar(x, y, n, ax, ay, bx, by);
+    }
+
+    const int64x2_t bias = vdupq_n_s64(farthestBias(ax, ay, bx, by));
+    const int64x2_t step = vdupq_n_s64(2);
+    const long long lanes[2] = {0, 1};
+
+    int64x2_t best = vdupq_n_s64(LLONG_MAX);
+    int64x2_t bi = vdupq_n_s64(0);
+    int64x2_t idx = vld1q_s64(lanes);
+
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+
+        int32x2_t px = vld1_s32(x + i);
+        int32x2_t py = vld1_s32(y + i);
+
+        int64x2_t d = vmull_n_s32(py, bx);
+        d = vmlsl_n_s32(d, py, ax);
+        d = vmlsl_n_s32(d, px, by);
+        d = vmlal_n_s32(d, px, ay);
+        d = vsubq_s64(d, bias);
+
+        uint64x2_t less = vcltq_s64(d, best);
+        best = vbslq_s64(less, d, best);
+        bi = vbslq_s64(less, idx, bi);
+        idx = vaddq_s64(idx, step);
+
+    }
+
+    long long lb[2], li[2];
+    vst1q_s64(lb, best);
+    vst1q_s64(li, bi);
+
+    int lane = lb[1] < lb[0] || (lb[1] == lb[0] && li[1] < li[0]) ? 1 : 0;
+    size_t far = (size_t)li[lane];
+    long long low = lb[lane];
+    long long kx = (long long)bx - ax, ky = (long long)by - ay;
+    for(; i<n; i++) {
+
+        long long d = kx * ((long long)y[i] - ay) - ky * ((long long)x[i] - ax);
+        if( d < low ) {
+            low = d;
+            far = i;
+        }
+
+    }
+
+    return far;
+
+}
+#endif
+
+#endif
+
+/*preprocessing kernels, picked once for the running CPU*/
+struct simdKernels {
+
+    size_t (*findStart)(const int* x, const int* y, size_t n);
+    void (*storeAngle)(const int* x, const int* y, size_t n, int x0, int y0, coord* out);
+    size_t (*farthest)(const int* x, const int* y, size_t n, int ax, int ay, int bx, int by);
+    void (*insideFan)(const fanTable& fan, const int* x, const int* y, size_t n, unsigned char* inside);
+    void (*hashStripes)(const coord* pts, size_t stripes, unsigned long long* acc);
+    const char* name;
+
+};
+
+simdKernels pickKernels() {
+
+#ifdef HULL_X86_SIMD
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports("avx512f") ) {
+        return {findStartAvx512, storeAngleAvx512, farthestAvx512, insideFanAvx512, hashStripesAvx512, "avx512"};
+    }
+    if( __builtin_cpu_supports("avx2") ) {
+        return {findStartAvx2, storeAngleAvx2, farthestAvx2, insideFanAvx2, hashStripesAvx2, "avx2"};
+    }
+#endif
+#ifdef HULL_NEON_SIMD
+    // 64-bit lane compares are AArch64 only, 32-bit NEON keeps the scalar reduction
+#ifdef __aarch64__
+    return {findStartNeon, storeAngleNeon, farthestNeon, insideFanScalar, hashStripesScalar, "neon"};
+#else
+    return {findStartNeon, storeAngleNeon, farthestScalar, insideFanScalar, hashStripesScalar, "neon"};
+#endif
+#endif
+    return {findStartScalar, storeAngleScalar, farthestScalar, insideFanScalar, hashStripesScalar, "scalar"};
+
+}
+
+const simdKernels& simd() {
+
+    static const simdKernels k = pickKernels();
+    return k;
+
+}
+
+/*finding the start point of a point set, kernels index in 32 bits so go block by block*/
+size_t findStart(const pointSet& pts) {
+
+    const size_t block = (size_t)1 << 30;
+    size_t n = pts.x.size();
+    const int* x = pts.x.data();
+    const int* y = pts.y.data();
+
+    size_t start = 0;
+    for(size_t off = 0; off < n; off += block) {
+
+        size_t len = n - off < block ? n - off : block;
+        size_t i = off + simd().findStart(x + off, y + off, len);
+        if( y[i] < y[start] || (y[i] == y[start] && x[i] < x[start]) ) {
+            start = i;
+        }
+
+    }
+
+    return start;
+
+}
+
+/*storing angle of a point set into coords, start point moved to the front like the AoS path*/
+void storeAngle(const pointSet& pts, coord* out) {
+
+    size_t n = pts.x.size();
+    if( n == 0 ) {
+        return;
+    }
+
+    size_t start = findStart(pts);
+    simd().storeAngle(pts.x.data(), pts.y.data(), n, pts.x[start], pts.y[start], out);
+
+    coord temp = out[0];
+    out[0] = out[start];
+    out[start] = temp;
+
+}
+
+/*where arenas get their blocks; plug in another one to place hull scratch memory elsewhere.
+  Every thread's arena draws from the same source, so it has to be thread-safe*/
+class blockSource {
+
+public:
+
+    virtual ~blockSource() {}
+    virtual void* allocate(size_t bytes) = 0;
+    virtual void deallocate(void* block, size_t bytes) = 0;
+
+};
+
+/*cache-line aligned blocks from the heap*/
+class heapSource : public blockSource {
+
+public:
+
+    void* allocate(size_t bytes) {
+
+        void* block = aligned_alloc(64, bytes);
+        if( block == NULL ) {
+            throw bad_alloc();
+        }
+        return block;
+
+    }
+
+    void deallocate(void* block, size_t) {
+
+        free(block);
+
+    }
+
+};
+
+/*the source new arenas draw from, set it before the first hull call*/
+blockSource*& defaultBlockSource() {
+
+    static heapSource heap;
+    static blockSource* source = &heap;
+    return source;
+
+}
+
+/*bump allocator for per-call scratch: take() carves buffers out of big blocks, rewind() gives
+  back everything taken since a mark. Emptied after spilling into several blocks, it swaps them
+  for one block of the peak size, so a steady workload stops calling its block source*/
+class scratchArena {
+
+public:
+
+    explicit scratchArena(blockSource* source = NULL)
+        : source(source != NULL ? source : defaultBlockSource()), current(0), used(0), peak(0),
+        requests(0) {}
+
+    ~scratchArena() {
+
+        releaseBlocks();
+
+    }
+
+    scratchArena(const scratchArena&) = delete;
+    scratchArena& operator=(const scratchArena&) = delete;
+
+    /*uninitialized room for n values of a trivially copyable T*/
+    template<typename T>
+    T* take(size_t n) {
+
+        return (T*)takeBytes(n * sizeof(T));
+
+    }
+
+    size_t mark() const {
+
+        return used;
+
+    }
+
+    void rewind(size_t to) {
+
+        while(current > 0 && blocks[current].start > to) {
+            current--;
+        }
+        used = to;
+
+        if( used == 0 && blocks.size() > 1 ) {
+            releaseBlocks();
+            addBlock(peak);
+        }
+
+    }
+
+    /*one block of at least bytes up front, for jobs whose peak is known; only while empty*/
+    void reserve(size_t bytes) {
+
+        if( used == 0 && reservedBytes() < bytes ) {
+            releaseBlocks();
+            addBlock(bytes);
+        }
+
+    }
+
+    /*most bytes in use at once, alignment padding included*/
+    size_t peakBytes() const {
+
+        return peak;
+
+    }
+
+    size_t usedBytes() const {
+
+        return used;
+
+    }
+
+    size_t reservedBytes() const {
+
+        return blocks.empty() ? 0 : blocks.back().start + blocks.back().size;
+
+    }
+
+    /*blocks asked from the source, zero across a run means no heap traffic*/
+    size_t blockRequests() const {
+
+        return requests;
+
+    }
+
+    void resetStats() {
+
+        peak = used;
+        requests = 0;
+
+    }
+
+private:
+
+    /*start is where the block begins in the arena's bytes, marks count across blocks*/
+    struct block {
+
+        char* data;
+        size_t size;
+        size_t start;
+
+    };
+
+    static constexpr size_t minBlock = (size_t)1 << 18;
+
+    void* takeBytes(size_t bytes) {
+
+        size_t aligned = (bytes + 63) & ~(size_t)63;
+        HULL_COUNT(scratchBytes, aligned);
+
+        while(current < blocks.size()) {
+
+            block& b = blocks[current];
+            if( used - b.start + aligned <= b.size ) {
+                void* p = b.data + (used - b.start);
+                used += aligned;
+                if( used > peak ) {
+                    peak = used;
+                }
+                return p;
+            }
+
+            // the rest of this block is skipped
+            if( current + 1 == blocks.size() ) {
+                break;
+            }
+            current++;
+            used = blocks[current].start;
+
+        }
+
+        size_t size = blocks.empty() ? aligned : max(aligned, 2 * blocks.back().size);
+        addBlock(size);
+        return takeBytes(bytes);
+
+    }
+
+    void addBlock(size_t size) {
+
+        size = (max(size, minBlock) + 63) & ~(size_t)63;
+
+        block b;
+        b.data = (char*)source->allocate(size);
+        b.size = size;
+        b.start = reservedBytes();
+        blocks.push_back(b);
+        requests++;
+
+        current = blocks.size() - 1;
+        used = b.start;
+
+    }
+
+    void releaseBlocks() {
+
+        for(block& b : blocks) {
+            source->deallocate(b.data, b.size);
+        }
+        blocks.clear();
+        current = 0;
+        used = 0;
+
+    }
+
+    blockSource* source;
+    vector<block> blocks;
+    size_t current;
+    size_t used;
+    size_t peak;
+    size_t requests;
+
+};
+
+/*the calling thread's arena, every engine takes its scratch buffers from it*/
+scratchArena& threadArena() {
+
+    static thread_local scratchArena arena;
+    return arena;
+
+}
+
+/*the calling thread's reusable scan stack, for engines running inside tasks*/
+vector<coord>& threadStack() {
+
+    static thread_local vector<coord> stack;
+    return stack;
+
+}
+
+/*gives back everything taken from the arena while it lives*/
+class arenaScope {
+
+public:
+
+    explicit arenaScope(scratchArena& arena) : arena(arena), start(arena.mark()) {}
+
+    ~arenaScope() {
+
+        arena.rewind(start);
+
+    }
+
+private:
+
+    scratchArena& arena;
+    size_t start;
+
+};
+
+/*merging sorted runs a[0..na) and b[0..nb) into dst, a goes first on ties*/
+void mergeRuns(const coord* a, size_t na, const coord* b, size_t nb, coord* dst) {
+
+    size_t i = 0, j = 0, k = 0;
+
+    while(i < na && j < nb) {
+
+        if( larger(a[i].ang, b[j].ang) == 2) {
+
+            dst[k] = a[i];
+            k++;
+            i++;
+        
+        }
+        else {
+
+            dst[k] = b[j];
+            k++;
+            j++;
+
+        }
+
+    }
+
+    while(i < na) {
+
+        dst[k] = a[i];
+        k++;
+        i++;
+
+    }
+
+    while(j < nb) {
+
+        dst[k] = b[j];
+        k++;
+        j++;
+
+    }
+
+}
+
+/*merging sorted parts src[start..mid] and src[mid+1..end] into dst*/
+void mergeSortedParts(const coord* src, coord* dst, size_t start, size_t mid, size_t end) {
+
+    mergeRuns(src + start, mid - start + 1, src + mid + 1, end - mid, dst + start);
+
+}
+
+/*insertion sort of arr[start..end] by angle, for ranges too short for merge passes to pay off*/
+void insertionSortAngle(coord* arr, size_t start, size_t end) {
+
+    for(size_t i=start+1; i<=end; i++) {
+
+        coord curr = arr[i];
+        size_t j = i;
+        while(j > start && larger(arr[j - 1].ang, curr.ang) == 1) {
+            arr[j] = arr[j - 1];
+            j--;
+        }
+        arr[j] = curr;
+
+    }
+
+}
+
+/*timsort's minimum run for n items: between 32 and 64, and n / minRun is a power of two or
+  just below one, so the final merges stay balanced*/
+size_t minRunLength(size_t n) {
+
+    size_t r = 0;
+    while(n >= 64) {
+        r |= n & 1;
+        n >>= 1;
+    }
+
+    return n + r;
+
+}
+
+/*merging the adjacent sorted runs arr[a, a + na) and arr[a + na, a + na + nb) through aux. The
+  head of the first run that is not above the second's first item stays put, and so does the
+  tail of the second run that is not below the first's last item; only the rest is merged,
+  and aux holds at least na coords*/
+void mergeAdjacentRuns(coord* arr, size_t a, size_t na, size_t nb, coord* aux) {
+
+    coord* first = arr + a;
+    coord* second = first + na;
+    if( larger(first[na - 1].ang, second[0].ang) != 1 ) {
+        return;
+    }
+
+    size_t lo = 0, hi = na - 1;
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if( larger(first[mid].ang, second[0].ang) == 1 ) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    size_t skip = lo;
+
+    lo = 0;
+    hi = nb - 1;
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if( larger(first[na - 1].ang, second[mid].ang) == 1 ) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    size_t keep = larger(first[na - 1].ang, second[lo].ang) == 1 ? lo + 1 : lo;
+
+    // the merge writes behind the second run's read position, so only the first needs a copy
+    for(size_t i=skip; i<na; i++) {
+        aux[i - skip] = first[i];
+    }
+    mergeRuns(aux, na - skip, second, keep, first + skip);
+
+}
+
+/*natural merge sort of arr[start..end] on basis of angle and distance, aux must hold at least
+  end + 1 coords. Ascending runs are taken as they are and strictly descending ones reversed,
+  runs shorter than minRunLength are extended by insertion sort, and adjacent runs are merged
+  timsort-style, keeping the pending run lengths growing at least like Fibonacci numbers.
+  Presorted input costs O(n), anything else O(n log n)*/
+void mergeSort(coord* arr, size_t start, size_t end, coord* aux) {
+
+    if(start >= end) {
+        return;
+    }
+
+    size_t n = end - start + 1, minRun = minRunLength(n);
+    size_t base[96], len[96];
+    int runs = 0;
+
+    auto mergeAt = [&](int k) {
+        // the scratch sits at the runs' own offset, so parallel sorts of disjoint ranges can share aux
+        mergeAdjacentRuns(arr, base[k], len[k], len[k + 1], aux + base[k]);
+        len[k] += len[k + 1];
+        for(int r=k+1; r<runs-1; r++) {
+            base[r] = base[r + 1];
+            len[r] = len[r + 1];
+        }
+        runs--;
+    };
+
+    for(size_t lo = start; lo <= end; ) {
+
+        size_t hi = lo + 1;
+        if( hi <= end && larger(arr[lo].ang, arr[hi].ang) == 1 ) {
+            while(hi + 1 <= end && larger(arr[hi].ang, arr[hi + 1].ang) == 1) {
+                hi++;
+            }
+            for(size_t i=lo, j=hi; i<j; i++, j--) {
+                coord t = arr[i];
+                arr[i] = arr[j];
+                arr[j] = t;
+            }
+        }
+        else {
+            while(hi <= end && larger(arr[hi - 1].ang, arr[hi].ang) != 1) {
+                hi++;
+            }
+            hi--;
+        }
+
+        size_t run = hi - lo + 1;
+        if( run < minRun ) {
+            run = min(minRun, end - lo + 1);
+            insertionSortAngle(arr, lo, lo + run - 1);
+        }
+
+        base[runs] = lo;
+        len[runs] = run;
+        runs++;
+        lo += run;
+
+        while(runs > 1) {
+
+            int k = runs - 2;
+            if( (k > 0 && len[k - 1] <= len[k] + len[k + 1]) || (k > 1 && len[k - 2] <= len[k - 1] + len[k]) ) {
+                if( len[k - 1] < len[k + 1] ) {
+                    k--;
+                }
+            }
+            else if( len[k] > len[k + 1] ) {
+                break;
+            }
+            mergeAt(k);
+
+        }
+
+    }
+
+    while(runs > 1) {
+
+        int k = runs - 2;
+        if( k > 0 && len[k - 1] < len[k + 1] ) {
+            k--;
+        }
+        mergeAt(k);
+
+    }
+
+}
+
+void mergeSort(coord* arr, size_t start, size_t end) {
+
+    arenaScope scope(threadArena());
+    mergeSort(arr, start, end, threadArena().take<coord>(end + 1));
+
+}
+
+/*function to print stack*/
+void printStack(const vector<coord>& stack) {
+
+    for(size_t i = stack.size(); i > 0; i--) {
+
+        cout << "(" << stack[i - 1].x << ", " << stack[i - 1].y << ")" << endl;
+
+    }
+    cout << endl;
+
+}
+
+/*scan tracers, step() sees the stack after every push and pop; the default one is empty
+  and compiles away*/
+struct noTrace {
+
+    void step(const vector<coord>&) {}
+
+};
+
+/*debugging hook for the scan, called after every push and pop*/
+typedef void (*scanCallback)(const vector<coord>& stack, void* user);
+
+struct callbackTrace {
+
+    scanCallback fn;
+    void* user;
+
+    void step(const vector<coord>& stack) {
+
+        fn(stack, user);
+
+    }
+
+};
+
+#ifndef HULL_QUIET
+/*prints every intermediate stack and waits for enter; builds with -DHULL_QUIET leave it out*/
+struct interactiveTrace {
+
+    void step(const vector<coord>& stack) {
+
+        printStack(stack);
+        pauseTrace();
+
+    }
+
+};
+#endif
+
+/*function to find hull of given points, stack is left holding the hull bottom to top*/
+template<typename Tracer>
+void findingHull(coord points[], size_t n, vector<coord>& stack, Tracer& trace){
+
+    stack.clear();
+    stack.reserve(n);
+
+    push(stack, points[0]);
+    push(stack, points[1]);
+    trace.step(stack);
+
+    for(size_t i=2; i<n; i++){
+
+        while(1){
+
+            size_t top = stack.size();
+            if( top == 1 ){
+
+                push(stack, points[i]);
+                trace.step(stack);
+                break;
+            
+            }
+            else{
+
+                if(!crossProduct(points[i], stack[top - 1], stack[top - 2])){
+                    pop(stack);
+                    trace.step(stack);
+                }
+                else{
+                    push(stack, points[i]);
+                    trace.step(stack);
+                    break;
+                }
+            
+            }
+
+        }
+    }
+    
+}
+
+void findingHull(coord points[], size_t n, vector<coord>& stack){
+
+    noTrace trace;
+    findingHull(points, n, stack, trace);
+
+}
+
+/*lexicographic (x, y) key, sign bits flipped so unsigned order matches signed order*/
+unsigned long long lexKey(coord c) {
+
+    unsigned long long hi = (unsigned)c.x ^ 0x80000000u;
+    unsigned long long lo = (unsigned)c.y ^ 0x80000000u;
+
+    return (hi << 32) | lo;
+
+}
+
+/*LSD radix sort by lexKey, 8 bits a pass; passes where all keys share the digit are skipped*/
+void radixSortLex(coord* pts, size_t n, coord* aux) {
+
+    if( n < 2 ) {
+        return;
+    }
+
+    size_t count[8 * 256] = {0};
+    for(size_t i=0; i<n; i++) {
+
+        unsigned long long key = lexKey(pts[i]);
+        for(int d=0; d<8; d++) {
+            count[d * 256 + ((key >> (8 * d)) & 255)]++;
+        }
+
+    }
+
+    coord* src = pts;
+    coord* dst = aux;
+
+    for(int d=0; d<8; d++) {
+
+        size_t* bucket = &count[d * 256];
+        if( bucket[(lexKey(src[0]) >> (8 * d)) & 255] == n ) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for(int b=0; b<256; b++) {
+            size_t c = bucket[b];
+            bucket[b] = offset;
+            offset += c;
+        }
+
+        for(size_t i=0; i<n; i++) {
+            dst[bucket[(lexKey(src[i]) >> (8 * d)) & 255]++] = src[i];
+        }
+
+        coord* temp = src;
+        src = dst;
+        dst = temp;
+
+    }
+
+    if( src != pts ) {
+        for(size_t i=0; i<n; i++) {
+            pts[i] = src[i];
+        }
+    }
+
+}
+
+/*angle sort key: exact pseudo-angle, distance along the ray for points on the same ray, and
+  where the point came from*/
+struct angleKey {
+
+    unsigned long long slope;
+    unsigned int dist;
+    unsigned int index;
+
+};
+
+/*exact monotone key for the angle of a around the start point: dy / (|dx| + dy) below 90
+  degrees, 1 + |dx| / (|dx| + dy) above, in fixed point with fracBits fraction bits. Distinct
+  slopes with |dx| + dy < 2^b differ by more than 2^-2b, so fracBits = 2b keeps them apart*/
+unsigned long long slopeKey(angle a, int fracBits) {
+
+    unsigned long long ax = a.x_diff < 0 ? 0 - (unsigned long long)(long long)a.x_diff : a.x_diff;
+    unsigned long long s = ax + (unsigned long long)a.y_diff;
+
+    if( s == 0 ) {
+        return 0;
+    }
+
+    if( a.x_diff >= 0 ) {
+        return (unsigned long long)(((unsigned __int128)(unsigned long long)a.y_diff << fracBits) / s);
+    }
+
+    return (1ull << fracBits) + (unsigned long long)(((unsigned __int128)ax << fracBits) / s);
+
+}
+
+/*digit d of a key, least significant first: four bytes of dist, then eight of slope*/
+unsigned angleDigit(const angleKey& k, int d) {
+
+    if( d < 4 ) {
+        return (k.dist >> (8 * d)) & 255;
+    }
+
+    return (unsigned)(k.slope >> (8 * (d - 4))) & 255;
+
+}
+
+/*LSD radix sort of arr[start..end] by angle, same order as mergeSort; aux must hold at least
+  end + 1 coords. Falls back to mergeSort when the offsets are too wide for a 64-bit key*/
+void radixSortAngle(coord* arr, size_t start, size_t end, coord* aux, angleKey* keys) {
+
+    if(start >= end) {
+        return;
+    }
+
+    size_t m = end - start + 1;
+
+    unsigned long long maxS = 0;
+    for(size_t i = start; i <= end; i++) {
+
+        long long dx = arr[i].ang.x_diff;
+        unsigned long long s = (unsigned long long)(dx < 0 ? -dx : dx) + (unsigned long long)arr[i].ang.y_diff;
+        if( s > maxS ) {
+            maxS = s;
+        }
+
+    }
+
+    int bits = 0;
+    while(bits < 64 && (1ull << bits) <= maxS) {
+        bits++;
+    }
+
+    if( bits > 31 || end > 0xFFFFFFFFull ) {
+        mergeSort(arr, start, end, aux);
+        return;
+    }
+
+    angleKey* src = keys;
+    angleKey* dst = src + m;
+
+    size_t count[12 * 256] = {0};
+    for(size_t i=0; i<m; i++) {
+
+        angle a = arr[start + i].ang;
+        src[i].slope = slopeKey(a, 2 * bits);
+        src[i].dist = (unsigned)(a.x_diff < 0 ? -a.x_diff : a.x_diff) + (unsigned)a.y_diff;
+        src[i].index = (unsigned)(start + i);
+
+        for(int d=0; d<12; d++) {
+            count[d * 256 + angleDigit(src[i], d)]++;
+        }
+
+    }
+
+    for(int d=0; d<12; d++) {
+
+        size_t* bucket = &count[d * 256];
+        if( bucket[angleDigit(src[0], d)] == m ) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for(int b=0; b<256; b++) {
+            size_t c = bucket[b];
+            bucket[b] = offset;
+            offset += c;
+        }
+
+        for(size_t i=0; i<m; i++) {
+            dst[bucket[angleDigit(src[i], d)]++] = src[i];
+        }
+
+        angleKey* temp = src;
+        src = dst;
+        dst = temp;
+
+    }
+
+    for(size_t i=0; i<m; i++) {
+        aux[start + i] = arr[src[i].index];
+    }
+    for(size_t i = start; i <= end; i++) {
+        arr[i] = aux[i];
+    }
+
+}
+
+/*merging sorted delta runs a[0..na) and b[0..nb) into dst, a goes first on ties*/
+void mergeDeltaRuns(const angle* a, size_t na, const angle* b, size_t nb, angle* dst) {
+
+    size_t i = 0, j = 0, k = 0;
+
+    while(i < na && j < nb) {
+        if( larger(a[i], b[j]) == 2 ) {
+            dst[k++] = a[i++];
+        }
+        else {
+            dst[k++] = b[j++];
+        }
+    }
+
+    while(i < na) {
+        dst[k++] = a[i++];
+    }
+    while(j < nb) {
+        dst[k++] = b[j++];
+    }
+
+}
+
+/*the angle sort of pts[1..n) around pts[0] on 8-byte deltas from it: a point is its delta
+  once the anchor is known, so the merge passes move half of what a coord is and one pass at
+  the end rebuilds the points. Same order as mergeSort*/
+void deltaSortAngle(coord* pts, size_t n) {
+
+    if( n < 3 ) {
+        return;
+    }
+
+    scratchArena& arena = threadArena();
+    arenaScope scope(arena);
+    size_t m = n - 1;
+    angle* src = arena.take<angle>(m);
+    angle* dst = arena.take<angle>(m);
+
+    int x0 = pts[0].x, y0 = pts[0].y;
+    for(size_t i=0; i<m; i++) {
+        src[i].x_diff = pts[i + 1].x - x0;
+        src[i].y_diff = pts[i + 1].y - y0;
+    }
+
+    for(size_t width=1; width<m; width*=2) {
+
+        for(size_t lo=0; lo<m; lo+=2*width) {
+            size_t mid = min(lo + width, m);
+            size_t hi = min(lo + 2 * width, m);
+            mergeDeltaRuns(src + lo, mid - lo, src + mid, hi - mid, dst + lo);
+        }
+
+        angle* temp = src;
+        src = dst;
+        dst = temp;
+
+    }
+
+    for(size_t i=0; i<m; i++) {
+        pts[i + 1].x = x0 + src[i].x_diff;
+        pts[i + 1].y = y0 + src[i].y_diff;
+        pts[i + 1].ang = src[i];
+    }
+
+}
+
+/*reversing out[start..end)*/
+void reverseRange(vector<coord>& out, size_t start, size_t end) {
+
+    while(start + 1 < end) {
+
+        coord temp = out[start];
+        out[start] = out[end - 1];
+        out[end - 1] = temp;
+        start++;
+        end--;
+
+    }
+
+}
+
+/*rotating a counter-clockwise hull so the lowest, then leftmost point comes first*/
+void rotateToLowest(vector<coord>& out) {
+
+    size_t start = 0;
+    for(size_t i=1; i<out.size(); i++) {
+        if( out[i].y < out[start].y || (out[i].y == out[start].y && out[i].x < out[start].x) ) {
+            start = i;
+        }
+    }
+
+    if( start != 0 ) {
+        reverseRange(out, 0, start);
+        reverseRange(out, start, out.size());
+        reverseRange(out, 0, out.size());
+    }
+
+}
+
+/*the chains of Andrew's algorithm over pts already sorted by (x, y)*/
+void monotoneChainSorted(const coord* pts, size_t n, vector<coord>& out) {
+
+    out.clear();
+    if( n == 0 ) {
+        return;
+    }
+
+    if( pts[0].x == pts[n - 1].x && pts[0].y == pts[n - 1].y ) {
+        out.push_back(pts[0]);
+        return;
+    }
+
+    out.reserve(n + 1);
+
+    // lower hull, left to right
+    for(size_t i=0; i<n; i++) {
+
+        while(out.size() >= 2 && !crossProduct(pts[i], out[out.size() - 1], out[out.size() - 2])) {
+            pop(out);
+        }
+        push(out, pts[i]);
+
+    }
+
+    // upper hull, right to left
+    size_t lower = out.size() + 1;
+    for(size_t i=n-1; i>0; i--) {
+
+        while(out.size() >= lower && !crossProduct(pts[i - 1], out[out.size() - 1], out[out.size() - 2])) {
+            pop(out);
+        }
+        push(out, pts[i - 1]);
+
+    }
+    pop(out);
+
+    rotateToLowest(out);
+
+}
+
+/*whether x never decreases, or never increases, along pts; stops at the first point that
+  breaks both*/
+bool xMonotone(const coord* pts, size_t n) {
+
+    bool up = true, down = true;
+    for(size_t i=1; i<n && (up || down); i++) {
+        up = up && pts[i].x >= pts[i - 1].x;
+        down = down && pts[i].x <= pts[i - 1].x;
+    }
+
+    return up || down;
+
+}
+
+/*puts points already sorted by x, either way round, into (x, y) order without a full sort:
+  descending input is reversed, then every run of equal x whose y is out of order is sorted on
+  its own. False, with pts untouched, when x is not monotone*/
+bool presortLex(coord* pts, size_t n, coord* aux) {
+
+    if( !xMonotone(pts, n) ) {
+        return false;
+    }
+
+    if( n > 1 && pts[0].x > pts[n - 1].x ) {
+        for(size_t i=0, j=n-1; i<j; i++, j--) {
+            coord t = pts[i];
+            pts[i] = pts[j];
+            pts[j] = t;
+        }
+    }
+
+    for(size_t g=0; g<n; ) {
+
+        size_t e = g + 1;
+        bool sorted = true;
+        while(e < n && pts[e].x == pts[g].x) {
+            sorted = sorted && pts[e].y >= pts[e - 1].y;
+            e++;
+        }
+        if( !sorted ) {
+            radixSortLex(pts + g, e - g, aux);
+        }
+        g = e;
+
+    }
+
+    return true;
+
+}
+
+/*Andrew's monotone chain on pts (reordered in place), same output order as findingHull*/
+void monotoneChain(coord* pts, size_t n, vector<coord>& out, coord* aux) {
+
+    if( !presortLex(pts, n, aux) ) {
+        radixSortLex(pts, n, aux);
+    }
+    monotoneChainSorted(pts, n, out);
+
+}
+
+/*Akl-Toussaint culling: compacts pts (order kept) to the points not strictly inside the
+  octagon of extreme points in x, y, x + y and x - y, returns how many were dropped*/
+size_t cullInterior(coord* pts, size_t n) {
+
+    if( n < 4 ) {
+        return 0;
+    }
+
+    // bottom, bottom-right, right, top-right, top, top-left, left, bottom-left
+    size_t ext[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    long long best[8];
+    for(int d=0; d<8; d++) {
+        best[d] = 0;
+    }
+
+    for(size_t i=0; i<n; i++) {
+
+        long long x = pts[i].x, y = pts[i].y;
+        long long key[8] = {-y, x - y, x, x + y, y, y - x, -x, -x - y};
+        for(int d=0; d<8; d++) {
+            if( i == 0 || key[d] > best[d] ) {
+                best[d] = key[d];
+                ext[d] = i;
+            }
+        }
+
+    }
+
+    // counter-clockwise octagon with repeated corners dropped
+    coord poly[8];
+    int m = 0;
+    for(int d=0; d<8; d++) {
+
+        coord c = pts[ext[d]];
+        if( m == 0 || c.x != poly[m - 1].x || c.y != poly[m - 1].y ) {
+            poly[m] = c;
+            m++;
+        }
+
+    }
+    while(m > 1 && poly[m - 1].x == poly[0].x && poly[m - 1].y == poly[0].y) {
+        m--;
+    }
+
+    if( m < 3 ) {
+        return 0;
+    }
+
+    // edges in double, padded to eight by repeating the first so the inner loop has a fixed trip count
+    double ax[8], ay[8], ex[8], ey[8];
+    for(int e=0; e<8; e++) {
+
+        int a = e < m ? e : 0;
+        int b = (a + 1) % m;
+        ax[e] = poly[a].x;
+        ay[e] = poly[a].y;
+        ex[e] = (double)poly[b].x - poly[a].x;
+        ey[e] = (double)poly[b].y - poly[a].y;
+
+    }
+
+    // products of 33-bit differences can round, a point only goes when it is clearly inside
+    const double eps = 1.0 / (1ull << 50);
+
+    size_t k = 0;
+    for(size_t i=0; i<n; i++) {
+
+        double px = pts[i].x, py = pts[i].y;
+        int inside = 1;
+        for(int e=0; e<8; e++) {
+
+            double t1 = ex[e] * (py - ay[e]);
+            double t2 = ey[e] * (px - ax[e]);
+            inside &= (t1 - t2) > (fabs(t1) + fabs(t2)) * eps;
+
+        }
+
+        pts[k] = pts[i];
+        k += !inside;
+
+    }
+
+    return n - k;
+
+}
+
+/*work-stealing thread pool: every worker owns a deque, takes its newest task first and
+  steals the oldest from the others when it runs dry*/
+class threadPool {
+
+public:
+
+    /*threads == 0 starts one worker per hardware thread*/
+    explicit threadPool(unsigned threads = 0) : stopping(false), pending(0), next(0) {
+
+        if( threads == 0 ) {
+            threads = thread::hardware_concurrency();
+        }
+        if( threads == 0 ) {
+            threads = 1;
+        }
+
+        for(unsigned i=0; i<threads; i++) {
+            queues.emplace_back(new taskQueue());
+        }
+        for(unsigned i=0; i<threads; i++) {
+            workers.emplace_back(&threadPool::workerLoop, this, i);
+        }
+
+    }
+
+    ~threadPool() {
+
+        {
+            lock_guard<mutex> lock(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+
+        for(size_t i=0; i<workers.size(); i++) {
+            workers[i].join();
+        }
+
+    }
+
+    unsigned size() const {
+
+        return (unsigned)workers.size();
+
+    }
+
+    void submit(function<void()> task) {
+
+        size_t q = currentPool == this ? currentWorker : next++ % queues.size();
+        {
+            lock_guard<mutex> lock(queues[q]->lock);
+            queues[q]->tasks.push_back(move(task));
+        }
+        pending++;
+
+        // taking the lock orders the increment against a worker about to sleep
+        { lock_guard<mutex> lock(sleepLock); }
+        wake.notify_one();
+
+    }
+
+    /*running one queued task on the calling thread, false when there was none*/
+    bool runPending() {
+
+        function<void()> task;
+        if( !take(task) ) {
+            return false;
+        }
+
+        task();
+        return true;
+
+    }
+
+private:
+
+    struct taskQueue {
+
+        mutex lock;
+        deque<function<void()>> tasks;
+
+    };
+
+    bool take(function<void()>& task) {
+
+        size_t count = queues.size();
+        size_t self = currentPool == this ? currentWorker : 0;
+
+        if( currentPool == this ) {
+
+            lock_guard<mutex> lock(queues[self]->lock);
+            deque<function<void()>>& own = queues[self]->tasks;
+            if( !own.empty() ) {
+                task = move(own.back());
+                own.pop_back();
+                pending--;
+                return true;
+            }
+
+        }
+
+        for(size_t k=0; k<count; k++) {
+
+            size_t q = (self + 1 + k) % count;
+            lock_guard<mutex> lock(queues[q]->lock);
+            deque<function<void()>>& other = queues[q]->tasks;
+            if( !other.empty() ) {
+                task = move(other.front());
+                other.pop_front();
+                pending--;
+                return true;
+            }
+
+        }
+
+        return false;
+
+    }
+
+    void workerLoop(unsigned id) {
+
+        currentPool = this;
+        currentWorker = id;
+
+        function<void()> task;
+        while(1) {
+
+            if( take(task) ) {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            unique_lock<mutex> lock(sleepLock);
+            wake.wait(lock, [this]{ return stopping || pending > 0; });
+            if( stopping && pending == 0 ) {
+                return;
+            }
+
+        }
+
+    }
+
+    vector<unique_ptr<taskQueue>> queues;
+    vector<thread> workers;
+    mutex sleepLock;
+    condition_variable wake;
+    bool stopping;
+    atomic<size_t> pending;
+    atomic<size_t> next;
+
+    static thread_local threadPool* currentPool;
+    static thread_local size_t currentWorker;
+
+};
+
+thread_local threadPool* threadPool::currentPool = NULL;
+thread_local size_t threadPool::currentWorker = 0;
+
+/*fork-join counter, wait() runs queued pool tasks until every task of the group is done. A
+  task that throws still counts as done; the first exception is kept and rethrown by wait() once
+  the rest of the group has finished, so no task outlives the frames it points into*/
+class taskGroup {
+
+public:
+
+    explicit taskGroup(threadPool& pool) : pool(pool), remaining(0) {}
+
+    /*draining only: a failure nobody waited for is dropped rather than thrown from here*/
+    ~taskGroup() {
+
+        drain();
+
+    }
+
+    void run(function<void()> task) {
+
+        remaining++;
+        pool.submit([this, task]{
+            try {
+                task();
+            }
+            catch(...) {
+                lock_guard<mutex> hold(failureLock);
+                if( !failure ) {
+                    failure = current_exception();
+                }
+            }
+            remaining--;
+        });
+
+    }
+
+    void wait() {
+
+        drain();
+
+        exception_ptr first;
+        {
+            lock_guard<mutex> hold(failureLock);
+            first.swap(failure);
+        }
+        if( first ) {
+            rethrow_exception(first);
+        }
+
+    }
+
+private:
+
+    void drain() {
+
+        while(remaining > 0) {
+            if( !pool.runPending() ) {
+                this_thread::yield();
+            }
+        }
+
+    }
+
+    threadPool& pool;
+    atomic<size_t> remaining;
+    mutex failureLock;
+    exception_ptr failure;
+
+};
+
+/*co-ranking: how many of the first k merged elements of a and b come from a*/
+size_t coRank(size_t k, const coord* a, size_t na, const coord* b, size_t nb) {
+
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = k < na ? k : na;
+
+    while(lo < hi) {
+
+        size_t i = lo + (hi - lo) / 2;
+
+        // a[i] is merged ahead of b[k - i - 1], so more than i come from a
+        if( larger(a[i].ang, b[k - i - 1].ang) == 2 ) {
+            lo = i + 1;
+        }
+        else {
+            hi = i;
+        }
+
+    }
+
+    return lo;
+
+}
+
+/*ranges at most this long are sorted or merged by a single task*/
+const size_t parallelSortCutoff = (size_t)1 << 14;
+
+/*merging src[start..mid] and src[mid+1..end] into dst as co-ranked pieces on the pool*/
+void parallelMergeParts(const coord* src, coord* dst, size_t start, size_t mid, size_t end, threadPool& pool) {
+
+    size_t total = end - start + 1;
+    size_t pieces = total / parallelSortCutoff;
+    if( pieces > (size_t)pool.size() * 4 ) {
+        pieces = (size_t)pool.size() * 4;
+    }
+
+    if( pieces < 2 ) {
+        mergeSortedParts(src, dst, start, mid, end);
+        return;
+    }
+
+    const coord* a = src + start;
+    const coord* b = src + mid + 1;
+    size_t na = mid - start + 1;
+    size_t nb = end - mid;
+
+    taskGroup group(pool);
+    for(size_t p=0; p<pieces; p++) {
+
+        size_t k0 = total * p / pieces;
+        size_t k1 = total * (p + 1) / pieces;
+
+        group.run([=]{
+            size_t i0 = coRank(k0, a, na, b, nb);
+            size_t i1 = coRank(k1, a, na, b, nb);
+            mergeRuns(a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0), dst + start + k0);
+        });
+
+    }
+    group.wait();
+
+}
+
+/*parallel top-down merge sort of [start..end] into dst; the data sits in dst when dataInDst,
+  otherwise in other, so no up-front copy is needed*/
+void parallelMergeSortSplit(coord* dst, coord* other, size_t start, size_t end, bool dataInDst, threadPool& pool) {
+
+    if( end - start + 1 <= parallelSortCutoff ) {
+
+        if( !dataInDst ) {
+            for(size_t i = start; i <= end; i++) {
+                dst[i] = other[i];
+            }
+        }
+        mergeSort(dst, start, end, other);
+        return;
+
+    }
+
+    size_t mid = start + (end - start) / 2;
+
+    taskGroup group(pool);
+    group.run([=, &pool]{
+        parallelMergeSortSplit(other, dst, start, mid, !dataInDst, pool);
+    });
+    parallelMergeSortSplit(other, dst, mid + 1, end, !dataInDst, pool);
+    group.wait();
+
+    parallelMergeParts(other, dst, start, mid, end, pool);
+
+}
+
+/*merge sorting on the pool, same order as mergeSort; aux must hold at least end + 1 coords*/
+void mergeSortParallel(coord* arr, size_t start, size_t end, coord* aux, threadPool& pool) {
+
+    if(start >= end) {
+        return;
+    }
+
+    parallelMergeSortSplit(arr, aux, start, end, true, pool);
+
+}
+
+/*hull engines selectable through computeHull*/
+enum hullEngine {
+
+    GRAHAM_SCAN,
+    MONOTONE_CHAIN,
+    CHAN_HULL,          // output-sensitive, for hulls far smaller than the input
+    QUICK_HULL,         // farthest-point recursion, parallel on opts.pool
+    MELKMAN_HULL,       // O(n) over the vertices of a simple polygon in order, never picked by AUTO_SELECT
+    AUTO_SELECT         // CHAN_HULL when a sample has a small hull, MONOTONE_CHAIN otherwise
+
+};
+
+/*how the Graham engine orders points by angle*/
+enum angleSort {
+
+    MERGE_SORT,
+    RADIX_SORT,
+    DELTA_SORT          // merge sort on 8-byte deltas from the start point, no stored angles
+
+};
+
+class hullDevice;
+class hullCache;
+
+/*inputs this big go to hullOptions::device by default, smaller ones do not fill enough blocks
+  for the staging to overlap anything*/
+const size_t offloadAutoMin = (size_t)1 << 22;
+
+/*engine choice and optional passes for computeHull*/
+struct hullOptions {
+
+    hullEngine engine = GRAHAM_SCAN;
+    bool cull = false;              // Akl-Toussaint pre-filter before sorting
+    threadPool* pool = NULL;        // partial hulls of chunks and the angle sort run here when set
+    angleSort sort = MERGE_SORT;
+    scanCallback trace = NULL;      // Graham scan debugging hook, checked once per call
+    void* traceUser = NULL;
+    hullDevice* device = NULL;      // culls and hulls blocks of big inputs when set, the engine finishes
+    size_t offloadMin = offloadAutoMin;
+    hullCache* cache = NULL;        // computeHull on a point buffer looks up and stores hulls here
+
+};
+
+/*per-caller state of hull calls; their scratch buffers come from threadArena()*/
+struct hullScratch {
+
+    vector<coord> work; // parsed text input
+    vector<coord> kept; // partial hulls handed back by a hullDevice
+    size_t culled = 0;  // points the pre-filter removed in the last call
+
+};
+
+/*sorting points by angle around the start point, aux holds n coords*/
+void sortPoints(coord* pts, size_t n, coord* aux) {
+
+    storeAngle(pts, n);
+    if( n > 2 ) {
+        mergeSort(pts, 1, n - 1, aux);
+    }
+
+}
+
+/*the same with aux grown once and reused*/
+void sortPoints(coord* pts, size_t n, vector<coord>& aux) {
+
+    if( aux.size() < n ) {
+        aux.resize(n);
+    }
+    sortPoints(pts, n, aux.data());
+
+}
+
+/*sorting a point set by angle into pts, which must hold pts.x.size() coords*/
+void sortPoints(const pointSet& set, coord* pts, vector<coord>& aux) {
+
+    size_t n = set.x.size();
+
+    storeAngle(set, pts);
+    if( n > 2 ) {
+        if( aux.size() < n ) {
+            aux.resize(n);
+        }
+        mergeSort(pts, 1, n - 1, aux.data());
+    }
+
+}
+
+void sortPoints(coord* pts, size_t n) {
+
+    arenaScope scope(threadArena());
+    sortPoints(pts, n, threadArena().take<coord>(n));
+
+}
+
+/*hull of points already sorted by sortPoints, counter-clockwise from the start point;
+  out doubles as the scan stack, so passing the same vector again reuses its buffer*/
+template<typename Tracer>
+void scanSorted(coord* pts, size_t n, vector<coord>& out, Tracer& trace) {
+
+    // copies of the start point sort first, keep only the last of them
+    size_t k = 1;
+    while(k < n && pts[k].x == pts[0].x && pts[k].y == pts[0].y) {
+        k++;
+    }
+    pts += k - 1;
+    n -= k - 1;
+
+    if( n < 3 ) {
+        out.assign(pts, pts + n);
+        return;
+    }
+
+    findingHull(pts, n, out, trace);
+
+}
+
+void scanSorted(coord* pts, size_t n, vector<coord>& out) {
+
+    noTrace trace;
+    scanSorted(pts, n, out, trace);
+
+}
+
+/*with a and b on one ray from p, whether a lies beyond b*/
+bool beyondOnRay(coord p, coord a, coord b) {
+
+    long long ax = llabs((long long)a.x - p.x), bx = llabs((long long)b.x - p.x);
+    return ax > bx || (ax == bx && llabs((long long)a.y - p.y) > llabs((long long)b.y - p.y));
+
+}
+
+/*gift wrapping from first over the group hulls in hulls, group g being [bounds[g], bounds[g + 1])
+  counter-clockwise from its lowest point. The tangent from the current vertex only moves forward
+  around every group, so each group keeps a cursor in at. False when the hull needs more than
+  limit vertices*/
+bool wrapGroups(coord first, const coord* hulls, const size_t* bounds, size_t groups, size_t limit,
+    size_t* at, vector<coord>& out) {
+
+    for(size_t g=0; g<groups; g++) {
+        at[g] = bounds[g];
+    }
+    out.clear();
+
+    coord p = first;
+    for(size_t step=0; step<limit; step++) {
+
+        push(out, p);
+
+        bool found = false;
+        coord best = p;
+        for(size_t g=0; g<groups; g++) {
+
+            size_t begin = bounds[g], k = bounds[g + 1] - begin;
+            size_t j = at[g];
+
+            // walking forward over the edges p sees from outside
+            for(size_t walk=1; walk<k; walk++) {
+
+                size_t next = j + 1 == begin + k ? begin : j + 1;
+                coord c = hulls[j];
+                if( c.x == p.x && c.y == p.y ) {
+                    j = next;
+                    continue;
+                }
+
+                int o = predicate<int>::orient(p.x, p.y, c.x, c.y, hulls[next].x, hulls[next].y);
+                if( o < 0 || (o == 0 && beyondOnRay(p, hulls[next], c)) ) {
+                    j = next;
+                    continue;
+                }
+                break;
+
+            }
+            at[g] = j;
+
+            coord c = hulls[j];
+            if( c.x == p.x && c.y == p.y ) {
+                continue;
+            }
+
+            int o = found ? predicate<int>::orient(p.x, p.y, best.x, best.y, c.x, c.y) : -1;
+            if( o < 0 || (o == 0 && beyondOnRay(p, c, best)) ) {
+                best = c;
+                found = true;
+            }
+
+        }
+
+        // nothing but copies of p, or back at the start
+        if( !found || (best.x == first.x && best.y == first.y) ) {
+            return true;
+        }
+        p = best;
+
+    }
+
+    return false;
+
+}
+
+/*Chan's output-sensitive hull, O(n log h): Graham hulls of groups of m points, then at most m
+  wrapping steps over them, squaring m until the wrap closes. Points on no group hull cannot be
+  on the hull, so each round only keeps the group hull vertices. pts is reordered and shrunk*/
+void chanHull(coord* pts, size_t n, vector<coord>& out) {
+
+    out.clear();
+    if( n == 0 ) {
+        return;
+    }
+
+    findStart(pts, n);
+    coord first = pts[0];
+
+    // group hulls never outgrow their groups, and there are at most n / 64 + 1 groups
+    scratchArena& arena = threadArena();
+    arenaScope scope(arena);
+    coord* hulls = arena.take<coord>(n);
+    size_t* bounds = arena.take<size_t>(n / 64 + 2);
+    size_t* cursors = arena.take<size_t>(n / 64 + 1);
+
+    for(size_t m=64; ; m=m*m) {
+
+        if( m > n ) {
+            m = n;
+        }
+        coord* aux = arena.take<coord>(m);
+
+        size_t groups = 0, total = 0;
+        bounds[0] = 0;
+        for(size_t begin=0; begin<n; begin+=m) {
+
+            size_t size = min(m, n - begin);
+            sortPoints(pts + begin, size, aux);
+            scanSorted(pts + begin, size, out);
+            for(size_t i=0; i<out.size(); i++) {
+                hulls[total++] = out[i];
+            }
+            bounds[++groups] = total;
+
+        }
+
+        if( wrapGroups(first, hulls, bounds, groups, m == n ? n + 1 : m, cursors, out) ) {
+            return;
+        }
+
+        n = total;
+        for(size_t i=0; i<n; i++) {
+            pts[i] = hulls[i];
+        }
+
+    }
+
+}
+
+/*below this many points the monotone chain's radix sort beats CHAN_HULL whatever h is, so
+  AUTO_SELECT does not sample; a sample hull of at most 1/autoHullRatio of the sample is small*/
+const size_t autoSampleMin = (size_t)1 << 19;
+const size_t autoHullRatio = 16;
+
+/*whether the hull of an evenly spread sample of pts is small, which is when CHAN_HULL beats
+  sorting everything; out is only used as a buffer*/
+bool smallHullExpected(const coord* pts, size_t n, vector<coord>& out) {
+
+    const size_t sample = 1024;
+    if( n < autoSampleMin ) {
+        return false;
+    }
+
+    scratchArena& arena = threadArena();
+    arenaScope scope(arena);
+    coord* picked = arena.take<coord>(2 * sample);
+    for(size_t i=0; i<sample; i++) {
+        picked[i] = pts[n / sample * i];
+    }
+
+    monotoneChain(picked, sample, out, picked + sample);
+    return out.size() * autoHullRatio <= sample;
+
+}
+
+/*inputs smaller than this per chunk are not worth a task*/
+const size_t parallelChunk = (size_t)1 << 15;
+
+/*QuickHull: the point farthest outside an edge a -> b is a hull vertex c, the outside points
+  of the edge are then outside a -> c, outside c -> b or inside the triangle. Outside means
+  strictly right, so chains run counter-clockwise. The points live in SoA buffers for the
+  farthest-point kernels, every edge owns a region that its two children split between them*/
+
+/*subproblems smaller than this stay on the thread that split them*/
+const size_t quickTaskMin = (size_t)1 << 13;
+
+/*chunk bounds of [0, n) for the parallel passes*/
+size_t chunkBegin(size_t n, size_t chunks, size_t c) {
+
+    return n / chunks * c + (c < n % chunks ? c : n % chunks);
+
+}
+
+/*how many chunks a parallel pass over n points uses, 1 when it should stay serial*/
+size_t passChunks(size_t n, threadPool* pool) {
+
+    if( pool == NULL || n < 2 * parallelChunk ) {
+        return 1;
+    }
+
+    return min((size_t)pool->size() * 4, n / parallelChunk);
+
+}
+
+/*index of the point of (x, y)[0..n) farthest right of a -> b*/
+size_t farthestOutside(const int* x, const int* y, size_t n, coord a, coord b, threadPool* pool) {
+
+    size_t chunks = passChunks(n, pool);
+    if( chunks == 1 ) {
+        return simd().farthest(x, y, n, a.x, a.y, b.x, b.y);
+    }
+
+    arenaScope scope(threadArena());
+    size_t* far = threadArena().take<size_t>(chunks);
+
+    taskGroup group(*pool);
+    for(size_t c=0; c<chunks; c++) {
+        group.run([=]{
+            size_t begin = chunkBegin(n, chunks, c), end = chunkBegin(n, chunks, c + 1);
+            far[c] = begin + simd().farthest(x + begin, y + begin, end - begin, a.x, a.y, b.x, b.y);
+        });
+    }
+    group.wait();
+
+    long long kx = (long long)b.x - a.x, ky = (long long)b.y - a.y;
+    size_t best = far[0];
+    long long low = 0;
+    for(size_t c=0; c<chunks; c++) {
+
+        long long d = kx * ((long long)y[far[c]] - a.y) - ky * ((long long)x[far[c]] - a.x);
+        if( c == 0 || d < low ) {
+            low = d;
+            best = far[c];
+        }
+
+    }
+
+    return best;
+
+}
+
+/*moving the points of src[0..n) right of a -> c to the front of dst and the ones right of
+  c -> b to its back. src has to hold a point on both lines, like c, so the two ends never
+  meet and both stores can be unconditional*/
+void splitOutsideSerial(const int* sx, const int* sy, size_t n, coord a, coord c, coord b,
+    int* dx, int* dy, size_t& front, size_t& back) {
+
+    size_t f = 0, g = n - 1;
+    for(size_t i=0; i<n; i++) {
+
+        int x = sx[i], y = sy[i];
+        int left = predicate<int>::orient(a.x, a.y, c.x, c.y, x, y) < 0;
+        int right = !left & (predicate<int>::orient(c.x, c.y, b.x, b.y, x, y) < 0);
+
+        dx[f] = x;
+        dy[f] = y;
+        dx[g] = x;
+        dy[g] = y;
+        f += left;
+        g -= right;
+
+    }
+
+    front = f;
+    back = n - 1 - g;
+
+}
+
+/*splitOutsideSerial on the pool: each chunk counts its points, then stores them at its offsets*/
+void splitOutside(const int* sx, const int* sy, size_t n, coord a, coord c, coord b,
+    int* dx, int* dy, size_t& front, size_t& back, threadPool* pool) {
+
+    size_t chunks = passChunks(n, pool);
+    if( chunks == 1 ) {
+        splitOutsideSerial(sx, sy, n, a, c, b, dx, dy, front, back);
+        return;
+    }
+
+    arenaScope scope(threadArena());
+    size_t* counts = threadArena().take<size_t>(2 * chunks);
+
+    auto side = [=](size_t i) {
+        if( predicate<int>::orient(a.x, a.y, c.x, c.y, sx[i], sy[i]) < 0 ) {
+            return 1;
+        }
+        return predicate<int>::orient(c.x, c.y, b.x, b.y, sx[i], sy[i]) < 0 ? 2 : 0;
+    };
+
+    taskGroup group(*pool);
+    for(size_t k=0; k<chunks; k++) {
+        group.run([=]{
+            size_t f = 0, g = 0;
+            for(size_t i=chunkBegin(n, chunks, k); i<chunkBegin(n, chunks, k + 1); i++) {
+                int s = side(i);
+                f += s == 1;
+                g += s == 2;
+            }
+            counts[2 * k] = f;
+            counts[2 * k + 1] = g;
+        });
+    }
+    group.wait();
+
+    size_t f = 0, g = 0;
+    for(size_t k=0; k<chunks; k++) {
+        size_t cf = counts[2 * k], cg = counts[2 * k + 1];
+        counts[2 * k] = f;
+        counts[2 * k + 1] = g;
+        f += cf;
+        g += cg;
+    }
+    front = f;
+    back = g;
+
+    for(size_t k=0; k<chunks; k++) {
+        group.run([=]{
+            size_t f = counts[2 * k], g = n - 1 - counts[2 * k + 1];
+            for(size_t i=chunkBegin(n, chunks, k); i<chunkBegin(n, chunks, k + 1); i++) {
+                int s = side(i);
+                if( s == 1 ) {
+                    dx[f] = sx[i];
+                    dy[f] = sy[i];
+                    f++;
+                }
+                else if( s == 2 ) {
+                    dx[g] = sx[i];
+                    dy[g] = sy[i];
+                    g--;
+                }
+            }
+        });
+    }
+    group.wait();
+
+}
+
+/*the hull chain strictly between a and b, in order, over the n points of (sx, sy) right of
+  a -> b. (dx, dy) is scratch of the same region and chain receives the vertices, returns how
+  many there are*/
+size_t quickChain(coord a, coord b, int* sx, int* sy, int* dx, int* dy, size_t n, coord* chain,
+    threadPool* pool) {
+
+    if( n == 0 ) {
+        return 0;
+    }
+
+    size_t far = farthestOutside(sx, sy, n, a, b, pool);
+    coord c = coord();
+    c.x = sx[far];
+    c.y = sy[far];
+
+    size_t front, back;
+    splitOutside(sx, sy, n, a, c, b, dx, dy, front, back, pool);
+
+    // the outsides of a -> c and c -> b keep the front and back of the region, c is in neither
+    size_t tail = n - back, left = 0, right = 0;
+    if( pool != NULL && front >= quickTaskMin && back >= quickTaskMin ) {
+
+        taskGroup group(*pool);
+        group.run([&]{
+            left = quickChain(a, c, dx, dy, sx, sy, front, chain, pool);
+        });
+        right = quickChain(c, b, dx + tail, dy + tail, sx + tail, sy + tail, back, chain + tail, pool);
+        group.wait();
+
+    }
+    else {
+
+        left = quickChain(a, c, dx, dy, sx, sy, front, chain, pool);
+        right = quickChain(c, b, dx + tail, dy + tail, sx + tail, sy + tail, back, chain + tail, pool);
+
+    }
+
+    chain[left] = c;
+    for(size_t i=0; i<right; i++) {
+        chain[left + 1 + i] = chain[tail + i];
+    }
+
+    return left + 1 + right;
+
+}
+
+/*dropping the vertices of a closed convex chain that lie on the segment between their neighbours;
+  ties for the farthest point can leave such vertices behind*/
+void dropCollinear(vector<coord>& out) {
+
+    size_t h = out.size();
+    if( h < 3 ) {
+        return;
+    }
+
+    coord prev = out[h - 1], first = out[0];
+    size_t k = 0;
+    for(size_t i=0; i<h; i++) {
+
+        coord cur = out[i];
+        coord next = i + 1 < h ? out[i + 1] : first;
+        if( predicate<int>::orient(prev.x, prev.y, cur.x, cur.y, next.x, next.y) != 0 ) {
+            out[k++] = cur;
+        }
+        prev = cur;
+
+    }
+    out.resize(k);
+
+}
+
+/*QuickHull of pts, the lower chain from the leftmost to the rightmost point and the upper chain
+  back, with the passes and both halves of big subproblems on pool when set*/
+void quickHull(const coord* pts, size_t n, vector<coord>& out, threadPool* pool) {
+
+    out.clear();
+    if( n == 0 ) {
+        return;
+    }
+
+    scratchArena& arena = threadArena();
+    arenaScope scope(arena);
+    int* x0 = arena.take<int>(n);
+    int* y0 = arena.take<int>(n);
+    int* x1 = arena.take<int>(n);
+    int* y1 = arena.take<int>(n);
+    coord* chain = arena.take<coord>(n);
+
+    // lexicographic (x, y) extremes, both hull vertices
+    size_t lo = 0, hi = 0;
+    for(size_t i=0; i<n; i++) {
+
+        x0[i] = pts[i].x;
+        y0[i] = pts[i].y;
+        if( pts[i].x < pts[lo].x || (pts[i].x == pts[lo].x && pts[i].y < pts[lo].y) ) {
+            lo = i;
+        }
+        if( pts[i].x > pts[hi].x || (pts[i].x == pts[hi].x && pts[i].y > pts[hi].y) ) {
+            hi = i;
+        }
+
+    }
+
+    coord a = pts[lo], b = pts[hi];
+    a.ang = b.ang = angle();
+    if( a.x == b.x && a.y == b.y ) {
+        out.push_back(a);
+        return;
+    }
+
+    size_t below, above;
+    splitOutside(x0, y0, n, a, b, a, x1, y1, below, above, pool);
+
+    size_t tail = n - above, lower = 0, upper = 0;
+    if( pool != NULL && below >= quickTaskMin && above >= quickTaskMin ) {
+
+        taskGroup group(*pool);
+        group.run([&]{
+            lower = quickChain(a, b, x1, y1, x0, y0, below, chain, pool);
+        });
+        upper = quickChain(b, a, x1 + tail, y1 + tail, x0 + tail, y0 + tail, above, chain + tail, pool);
+        group.wait();
+
+    }
+    else {
+
+        lower = quickChain(a, b, x1, y1, x0, y0, below, chain, pool);
+        upper = quickChain(b, a, x1 + tail, y1 + tail, x0 + tail, y0 + tail, above, chain + tail, pool);
+
+    }
+
+    out.reserve(lower + upper + 2);
+    out.push_back(a);
+    out.insert(out.end(), chain, chain + lower);
+    out.push_back(b);
+    out.insert(out.end(), chain + tail, chain + tail + upper);
+
+    dropCollinear(out);
+    rotateToLowest(out);
+
+}
+
+/*Melkman's O(n) hull of the vertices of a simple polygon or polyline, in order and in either
+  orientation. The hull so far is a deque with the latest vertex at both ends: a vertex left of
+  both end edges is inside and skipped, otherwise each end is popped until the vertex makes a
+  left turn there and it is pushed onto both. On input that is not simple the result is not
+  the hull. Points all on one line go to the monotone chain*/
+void melkmanHull(const coord* pts, size_t n, vector<coord>& out) {
+
+    out.clear();
+
+    // the first vertex, the last one in line with it and the first one off that line
+    size_t f = 1;
+    while(f < n && pts[f].x == pts[0].x && pts[f].y == pts[0].y) {
+        f++;
+    }
+    size_t k = f + 1;
+    while(k < n && predicate<int>::orient(pts[0].x, pts[0].y, pts[f].x, pts[f].y, pts[k].x, pts[k].y) == 0) {
+        k++;
+    }
+
+    scratchArena& arena = threadArena();
+    arenaScope scope(arena);
+    if( k >= n ) {
+        coord* work = arena.take<coord>(n);
+        for(size_t i=0; i<n; i++) {
+            work[i] = pts[i];
+        }
+        monotoneChain(work, n, out, arena.take<coord>(n));
+        return;
+    }
+
+    coord* d = arena.take<coord>(2 * n + 2);
+    size_t bot = n, top = n + 3;
+    coord a = pts[0], b = pts[k - 1], c = pts[k];
+    bool left = predicate<int>::orient(a.x, a.y, b.x, b.y, c.x, c.y) > 0;
+    d[bot] = c;
+    d[bot + 1] = left ? a : b;
+    d[bot + 2] = left ? b : a;
+    d[top] = c;
+
+    auto turn = [](const coord& p, const coord& q, const coord& r) {
+        return predicate<int>::orient(p.x, p.y, q.x, q.y, r.x, r.y);
+    };
+
+    for(size_t i=k+1; i<n; i++) {
+
+        const coord& p = pts[i];
+        if( turn(d[top - 1], d[top], p) > 0 && turn(d[bot], d[bot + 1], p) > 0 ) {
+            continue;
+        }
+
+        while(top > bot + 1 && turn(d[top - 1], d[top], p) <= 0) {
+            top--;
+        }
+        d[++top] = p;
+        while(bot + 1 < top && turn(p, d[bot], d[bot + 1]) <= 0) {
+            bot++;
+        }
+        d[--bot] = p;
+
+    }
+
+    out.assign(d + bot, d + top);
+    dropCollinear(out);
+    rotateToLowest(out);
+
+}
+
+/*the Graham angle sort of work[1..n) chosen by opts, aux holds n coords*/
+void angleSortWork(coord* work, size_t n, coord* aux, const hullOptions& opts) {
+
+    HULL_STAGE(STAGE_SORT);
+
+    if( opts.sort == DELTA_SORT ) {
+        deltaSortAngle(work, n);
+    }
+    else if( n > 2 && opts.sort == RADIX_SORT ) {
+        arenaScope scope(threadArena());
+        radixSortAngle(work, 1, n - 1, aux, threadArena().take<angleKey>(2 * (n - 1)));
+    }
+    else if( n > 2 && opts.pool != NULL ) {
+        mergeSortParallel(work, 1, n - 1, aux, *opts.pool);
+    }
+    else if( n > 2 ) {
+        mergeSort(work, 1, n - 1, aux);
+    }
+
+}
+
+/*running the chosen engine over the n points in work, which it reorders*/
+void hullOfWork(coord* work, size_t n, vector<coord>& out, hullScratch& scratch, const hullOptions& opts) {
+
+    // the start point is a hull vertex and compaction keeps order, so it stays in front;
+    // Melkman needs every vertex of the polygon, the culled points would leave a chain that crosses itself
+    {
+        HULL_STAGE(STAGE_CULL);
+        scratch.culled = opts.cull && opts.engine != MELKMAN_HULL ? cullInterior(work, n) : 0;
+    }
+    HULL_COUNT(culled, scratch.culled);
+    n -= scratch.culled;
+
+    hullEngine engine = opts.engine;
+    // input sorted by x spares the monotone chain its sort, nothing beats that
+    if( engine == AUTO_SELECT ) {
+        engine = xMonotone(work, n) || !smallHullExpected(work, n, out) ? MONOTONE_CHAIN : CHAN_HULL;
+    }
+
+    if( engine == CHAN_HULL ) {
+        HULL_STAGE(STAGE_CHAN);
+        chanHull(work, n, out);
+        return;
+    }
+
+    if( engine == QUICK_HULL ) {
+        HULL_STAGE(STAGE_QUICK);
+        quickHull(work, n, out, opts.pool);
+        return;
+    }
+
+    if( engine == MELKMAN_HULL ) {
+        HULL_STAGE(STAGE_CHAINS);
+        melkmanHull(work, n, out);
+        return;
+    }
+
+    scratchArena& arena = threadArena();
+    arenaScope scope(arena);
+    coord* aux = arena.take<coord>(n);
+
+    if( engine == MONOTONE_CHAIN ) {
+        HULL_STAGE(STAGE_CHAINS);
+        monotoneChain(work, n, out, aux);
+        return;
+    }
+
+    angleSortWork(work, n, aux, opts);
+
+    HULL_STAGE(STAGE_SCAN);
+    if( opts.trace != NULL ) {
+        callbackTrace trace = {opts.trace, opts.traceUser};
+        scanSorted(work, n, out, trace);
+    }
+    else {
+        scanSorted(work, n, out);
+    }
+
+}
+
+/*loading points [begin, end) of the input as coords into dst*/
+typedef function<void(size_t begin, size_t end, coord* dst)> pointLoader;
+
+/*hull of the n points already in work, which it reorders; only the angle sort and QUICK_HULL
+  use opts.pool*/
+void hullInPlace(coord* work, size_t n, vector<coord>& out, hullScratch& scratch, const hullOptions& opts) {
+
+    // work may be NULL then, as for an empty parsed file
+    if( n == 0 ) {
+        out.clear();
+        scratch.culled = 0;
+        return;
+    }
+
+    {
+        HULL_STAGE(STAGE_ANGLES);
+        if( opts.engine == GRAHAM_SCAN && opts.sort == DELTA_SORT ) {
+            findStart(work, n);
+        }
+        else if( opts.engine == GRAHAM_SCAN ) {
+            storeAngle(work, n);
+        }
+    }
+
+    hullOfWork(work, n, out, scratch, opts);
+
+}
+
+/*hull of the first n loaded points*/
+void serialHull(size_t n, const pointLoader& load, vector<coord>& out, hullScratch& scratch,
+    const hullOptions& opts) {
+
+    arenaScope scope(threadArena());
+    coord* work = threadArena().take<coord>(n);
+
+    load(0, n, work);
+    hullInPlace(work, n, out, scratch, opts);
+
+}
+
+/*partial hulls of chunks on the pool, then one serial pass over their union; the union holds
+  every hull vertex, so the result is the same as the serial path*/
+void parallelHull(size_t n, const pointLoader& load, vector<coord>& out, hullScratch& scratch,
+    const hullOptions& opts) {
+
+    hullOptions serial = opts;
+    serial.pool = NULL;
+
+    size_t chunks = (size_t)opts.pool->size() * 4;
+    if( n / chunks < parallelChunk ) {
+        chunks = n / parallelChunk;
+    }
+
+    if( chunks < 2 ) {
+        serialHull(n, load, out, scratch, opts);
+        return;
+    }
+
+    // each partial hull goes where its chunk starts, the tasks work in their own thread's arena
+    scratchArena& arena = threadArena();
+    arenaScope scope(arena);
+    coord* merged = arena.take<coord>(n);
+    size_t* sizes = arena.take<size_t>(chunks);
+    size_t* culled = arena.take<size_t>(chunks);
+
+    taskGroup group(*opts.pool);
+    for(size_t c=0; c<chunks; c++) {
+
+        size_t begin = n / chunks * c + (c < n % chunks ? c : n % chunks);
+        size_t end = begin + n / chunks + (c < n % chunks ? 1 : 0);
+
+        group.run([&, c, begin, end]{
+            pointLoader slice = [&load, begin](size_t b, size_t e, coord* dst) {
+                load(begin + b, begin + e, dst);
+            };
+            hullScratch local;
+            vector<coord>& partial = threadStack();
+            serialHull(end - begin, slice, partial, local, serial);
+            for(size_t i=0; i<partial.size(); i++) {
+                merged[begin + i] = partial[i];
+            }
+            sizes[c] = partial.size();
+            culled[c] = local.culled;
+        });
+
+    }
+    group.wait();
+
+    size_t total = 0, removed = 0;
+    for(size_t c=0; c<chunks; c++) {
+        size_t begin = n / chunks * c + (c < n % chunks ? c : n % chunks);
+        for(size_t i=0; i<sizes[c]; i++) {
+            merged[total++] = merged[begin + i];
+        }
+        removed += culled[c];
+    }
+
+    // with h close to n the union is as big as the input, so its sort stays on the pool
+    hullOptions last = opts;
+    last.cull = false;
+    hullInPlace(merged, total, out, scratch, last);
+    scratch.culled = removed;
+
+}
+
+/*where big inputs are cut down before an engine sees them: blocks of points are staged in
+  buffers the device owns, launch() starts culling a block and hulling its parts without waiting
+  and finish() hands back the partial hulls. Two slots let one block be staged while the other
+  is in flight, so a CUDA or SYCL backend maps them to pinned buffers with a stream each. A
+  device serves one hull call at a time, from its first launch() to its last finish()*/
+class hullDevice {
+
+public:
+
+    virtual ~hullDevice() {}
+
+    /*points a staging slot holds*/
+    virtual size_t blockPoints() const = 0;
+
+    /*staging buffer of slot 0 or 1, free to fill once the slot's last block is finished*/
+    virtual coord* staging(int slot) = 0;
+
+    /*starting on the first n points staged in slot*/
+    virtual void launch(int slot, size_t n) = 0;
+
+    /*waiting for slot and appending the partial hulls of its block to out*/
+    virtual void finish(int slot, vector<coord>& out) = 0;
+
+};
+
+/*hullDevice on a threadPool: each block is cut into parts that are culled and monotone-chained
+  as pool tasks, staging is plain host memory*/
+class hostDevice : public hullDevice {
+
+public:
+
+    explicit hostDevice(threadPool& pool, size_t block = (size_t)1 << 20) : block(block) {
+
+        for(int s=0; s<2; s++) {
+
+            slots[s].points.resize(block);
+            slots[s].parts = min((size_t)pool.size() * 2, block / 1024 + 1);
+            slots[s].sizes.resize(slots[s].parts);
+            slots[s].n = 0;
+            slots[s].group.reset(new taskGroup(pool));
+
+        }
+
+    }
+
+    size_t blockPoints() const {
+
+        return block;
+
+    }
+
+    coord* staging(int slot) {
+
+        return slots[slot].points.data();
+
+    }
+
+    void launch(int slot, size_t n) {
+
+        deviceSlot& s = slots[slot];
+        s.n = n;
+        for(size_t p=0; p<s.parts; p++) {
+
+            s.group->run([&s, p, n]{
+                size_t begin = chunkBegin(n, s.parts, p), end = chunkBegin(n, s.parts, p + 1);
+                coord* pts = s.points.data() + begin;
+                size_t m = end - begin;
+                m -= cullInterior(pts, m);
+
+                scratchArena& arena = threadArena();
+                arenaScope scope(arena);
+                vector<coord>& hull = threadStack();
+                monotoneChain(pts, m, hull, arena.take<coord>(m));
+                for(size_t i=0; i<hull.size(); i++) {
+                    pts[i] = hull[i];
+                }
+                s.sizes[p] = hull.size();
+            });
+
+        }
+
+    }
+
+    void finish(int slot, vector<coord>& out) {
+
+        deviceSlot& s = slots[slot];
+        s.group->wait();
+        for(size_t p=0; p<s.parts; p++) {
+            const coord* part = s.points.data() + chunkBegin(s.n, s.parts, p);
+            out.insert(out.end(), part, part + s.sizes[p]);
+        }
+
+    }
+
+private:
+
+    struct deviceSlot {
+
+        vector<coord> points;
+        vector<size_t> sizes;
+        size_t parts, n;
+        unique_ptr<taskGroup> group;
+
+    };
+
+    size_t block;
+    deviceSlot slots[2];
+
+};
+
+/*hull of n loaded points through opts.device: blocks alternate between the two slots, the next
+  one is loaded while the device works on the last, then the engine of opts runs over the partial
+  hulls. Every hull vertex is a vertex of its block's hull, so the result is the same as the CPU's*/
+void offloadHull(size_t n, const pointLoader& load, vector<coord>& out, hullScratch& scratch,
+    const hullOptions& opts) {
+
+    hullDevice& device = *opts.device;
+    size_t block = device.blockPoints();
+    size_t blocks = (n + block - 1) / block;
+    scratch.kept.clear();
+
+    // a throw from load() or finish() must not leave the other slot's block in flight
+    bool launched[2] = {false, false};
+    try {
+
+        if( n > 0 ) {
+            load(0, min(block, n), device.staging(0));
+            device.launch(0, min(block, n));
+            launched[0] = true;
+        }
+
+        for(size_t k=0; k<blocks; k++) {
+
+            int slot = (int)(k & 1);
+            size_t next = (k + 1) * block;
+            if( next < n ) {
+                size_t len = min(block, n - next);
+                load(next, next + len, device.staging(1 - slot));
+                device.launch(1 - slot, len);
+                launched[1 - slot] = true;
+            }
+            launched[slot] = false;
+            device.finish(slot, scratch.kept);
+
+        }
+
+    }
+    catch(...) {
+        for(int slot=0; slot<2; slot++) {
+            if( launched[slot] ) {
+                vector<coord> dropped;
+                try {
+                    device.finish(slot, dropped);
+                }
+                catch(...) {
+                    // the exception already on its way out is the one reported
+                }
+            }
+        }
+        throw;
+    }
+
+    // nothing came back for no points, and kept.data() may be NULL then
+    if( scratch.kept.empty() ) {
+        out.clear();
+        scratch.culled = 0;
+        return;
+    }
+
+    hullOptions last = opts;
+    last.cull = false;
+    last.device = NULL;
+    hullInPlace(scratch.kept.data(), scratch.kept.size(), out, scratch, last);
+
+}
+
+void hullOfLoader(size_t n, const pointLoader& load, vector<coord>& out, hullScratch& scratch,
+    const hullOptions& opts) {
+
+    // Melkman is one pass over the polygon in order, blocks or chunks of it would not be simple
+    if( opts.engine == MELKMAN_HULL ) {
+        serialHull(n, load, out, scratch, opts);
+    }
+    else if( opts.device != NULL && n >= opts.offloadMin ) {
+        offloadHull(n, load, out, scratch, opts);
+    }
+    // QuickHull splits the whole input on the pool itself, chunk hulls first would only add a pass
+    else if( opts.pool != NULL && opts.engine != QUICK_HULL ) {
+        parallelHull(n, load, out, scratch, opts);
+    }
+    else {
+        serialHull(n, load, out, scratch, opts);
+    }
+
+}
+
+/*64-bit content hash of the x and y of n points, xxHash-style: eight lanes of 32 x 32-bit
+  multiply-accumulate, scrambled block by block, then folded by 128-bit products with the
+  count mixed in. Every kernel gives the same value*/
+unsigned long long hashPoints(const coord* pts, size_t n) {
+
+    unsigned long long acc[8];
+    for(int j=0; j<8; j++) {
+        acc[j] = hashScramble[7 - j];
+    }
+
+    size_t stripes = n / 8;
+    simd().hashStripes(pts, stripes, acc);
+    for(size_t i=stripes*8; i<n; i++) {
+        acc[i & 7] = hashStep(acc[i & 7], hashWord(pts[i]), hashSecret[i & 7]);
+    }
+
+    unsigned long long h = (unsigned long long)n * 0x9e3779b185ebca87ULL;
+    for(int j=0; j<8; j+=2) {
+        unsigned __int128 m = (unsigned __int128)(acc[j] ^ hashSecret[j]) * (acc[j + 1] ^ hashScramble[j]);
+        h += (unsigned long long)m ^ (unsigned long long)(m >> 64);
+    }
+
+    h ^= h >> 37;
+    h *= 0x165667919e3779f9ULL;
+    return h ^ (h >> 32);
+
+}
+
+/*what a hullCache has done since it was made*/
+struct hullCacheStats {
+
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+
+};
+
+/*thread-safe LRU cache of finished hulls keyed by hashPoints and the point count. It holds at
+  most `budget` bytes of hulls and bookkeeping and evicts the least recently used hull first;
+  a hull bigger than the whole budget is not kept. Two point sets of the same size and hash
+  share an entry, which for 64-bit hashes of distinct inputs is a 2^-64 chance*/
+class hullCache {
+
+public:
+
+    explicit hullCache(size_t budget) : budget(budget) {}
+
+    /*copies the cached hull to out and marks it used, false on a miss*/
+    bool find(unsigned long long key, size_t n, vector<coord>& out) {
+
+        lock_guard<mutex> hold(lock);
+        auto it = index.find(key);
+        if( it == index.end() || it->second->n != n ) {
+            counts.misses++;
+            return false;
+        }
+
+        order.splice(order.begin(), order, it->second);
+        out.assign(it->second->hull.begin(), it->second->hull.end());
+        counts.hits++;
+        return true;
+
+    }
+
+    void insert(unsigned long long key, size_t n, const vector<coord>& hull) {
+
+        size_t bytes = entryBytes(hull.size());
+        if( bytes > budget ) {
+            return;
+        }
+
+        lock_guard<mutex> hold(lock);
+        auto it = index.find(key);
+        if( it != index.end() ) {
+            drop(it->second);
+        }
+
+        while(counts.bytes + bytes > budget) {
+            drop(prev(order.end()));
+            counts.evictions++;
+        }
+
+        order.push_front(entry{key, n, hull});
+        index[key] = order.begin();
+        counts.bytes += bytes;
+        counts.entries++;
+
+    }
+
+    void clear() {
+
+        lock_guard<mutex> hold(lock);
+        order.clear();
+        index.clear();
+        counts.bytes = 0;
+        counts.entries = 0;
+
+    }
+
+    hullCacheStats stats() const {
+
+        lock_guard<mutex> hold(lock);
+        return counts;
+
+    }
+
+private:
+
+    struct entry {
+
+        unsigned long long key;
+        size_t n;
+        vector<coord> hull;
+
+    };
+
+    /*an entry's vertices and list node, two links, and its index node: link, bucket, key and
+      iterator*/
+    static size_t entryBytes(size_t h) {
+
+        return h * sizeof(coord) + sizeof(entry) + 5 * sizeof(void*) + sizeof(unsigned long long);
+
+    }
+
+    void drop(list<entry>::iterator e) {
+
+        counts.bytes -= entryBytes(e->hull.size());
+        counts.entries--;
+        index.erase(e->key);
+        order.erase(e);
+
+    }
+
+    mutable mutex lock;
+    list<entry> order;  // most recently used first
+    unordered_map<unsigned long long, list<entry>::iterator> index;
+    size_t budget;
+    hullCacheStats counts;
+
+};
+
+/*whether a call with opts looks up and stores hulls in opts.cache. The key is the points
+  alone, and Melkman's output is a hull only when the points are a simple polygon, so its
+  results are never stored where another engine would get them back*/
+bool cachedHull(const hullOptions& opts) {
+
+    return opts.cache != NULL && opts.engine != MELKMAN_HULL;
+
+}
+
+/*convex hull of n points, the input buffer is left untouched*/
+void computeHull(const coord* pts, size_t n, vector<coord>& out, hullScratch& scratch,
+    const hullOptions& opts) {
+
+    // a hit skips every stage, the hull is copied out as it was stored and nothing was culled
+    if( cachedHull(opts) ) {
+
+        unsigned long long key = hashPoints(pts, n);
+        if( opts.cache->find(key, n, out) ) {
+            scratch.culled = 0;
+            return;
+        }
+
+        hullOptions uncached = opts;
+        uncached.cache = NULL;
+        computeHull(pts, n, out, scratch, uncached);
+        opts.cache->insert(key, n, out);
+        return;
+
+    }
+
+    pointLoader load = [pts](size_t b, size_t e, coord* dst) {
+        for(size_t i=b; i<e; i++) {
+            dst[i - b] = pts[i];
+        }
+    };
+
+    hullOfLoader(n, load, out, scratch, opts);
+
+}
+
+void computeHull(const pointSet& pts, vector<coord>& out, hullScratch& scratch,
+    const hullOptions& opts) {
+
+    size_t n = pts.x.size();
+
+    // the Graham start point search runs on the SoA kernels when the whole set is one chunk;
+    // it moves the start point to the front, which Melkman cannot have
+    if( opts.pool == NULL && (opts.device == NULL || n < opts.offloadMin) && opts.engine != MELKMAN_HULL ) {
+
+        arenaScope scope(threadArena());
+        coord* work = threadArena().take<coord>(n);
+        storeAngle(pts, work);
+        hullOfWork(work, n, out, scratch, opts);
+        return;
+
+    }
+
+    pointLoader load = [&pts](size_t b, size_t e, coord* dst) {
+        simd().storeAngle(pts.x.data() + b, pts.y.data() + b, e - b, 0, 0, dst);
+    };
+
+    hullOfLoader(n, load, out, scratch, opts);
+
+}
+
+void computeHull(const coord* pts, size_t n, vector<coord>& out, hullScratch& scratch,
+    hullEngine engine = GRAHAM_SCAN) {
+
+    computeHull(pts, n, out, scratch, hullOptions{engine, false, NULL});
+
+}
+
+void computeHull(const pointSet& pts, vector<coord>& out, hullScratch& scratch,
+    hullEngine engine = GRAHAM_SCAN) {
+
+    computeHull(pts, out, scratch, hullOptions{engine, false, NULL});
+
+}
+
+void computeHull(const coord* pts, size_t n, vector<coord>& out, hullEngine engine = GRAHAM_SCAN) {
+
+    hullScratch scratch;
+    computeHull(pts, n, out, scratch, engine);
+
+}
+
+/*sets up to this size skip the merge sort for an insertion sort*/
+const size_t smallSetMax = 64;
+
+/*hull of one set of a batch written to dst, returns its size; out is the scan stack*/
+size_t batchHull(const coord* pts, size_t n, coord* dst, vector<coord>& out, hullScratch& scratch,
+    const hullOptions& opts) {
+
+    // the fixed-size kernels need neither scratch nor angles
+    if( n <= hull::smallKernelMax ) {
+
+        size_t idx[hull::smallKernelMax + 1];
+        size_t h = hull::smallHullOf(pts, n, idx);
+        for(size_t i=0; i<h; i++) {
+            dst[i] = pts[idx[i]];
+        }
+        return h;
+
+    }
+
+    if( n > smallSetMax ) {
+        computeHull(pts, n, out, scratch, opts);
+    }
+    else {
+
+        arenaScope scope(threadArena());
+        coord* work = threadArena().take<coord>(n);
+        for(size_t i=0; i<n; i++) {
+            work[i] = pts[i];
+        }
+
+        storeAngle(work, n);
+        if( n > 2 ) {
+            insertionSortAngle(work, 1, n - 1);
+        }
+        scanSorted(work, n, out);
+
+    }
+
+    for(size_t i=0; i<out.size(); i++) {
+        dst[i] = out[i];
+    }
+    return out.size();
+
+}
+
+/*hulls of many point sets in CSR layout: set s is pts[offsets[s], offsets[s + 1]) and its hull
+  lands in hulls[hullOffsets[s], hullOffsets[s + 1]). Scratch is reused across sets, and with
+  opts.pool the sets are shared out over it, each set staying on one thread*/
+void computeHulls(const coord* pts, const size_t* offsets, size_t sets, vector<coord>& hulls,
+    vector<size_t>& hullOffsets, hullScratch& scratch, const hullOptions& opts) {
+
+    size_t base = sets > 0 ? offsets[0] : 0;
+    hulls.resize(sets > 0 ? offsets[sets] - base : 0);
+    hullOffsets.assign(sets + 1, 0);
+
+    // every hull first goes where its set starts, it can be no longer than the set; a device
+    // serves one call at a time, so sets running side by side on the pool must not share it
+    hullOptions serial = opts;
+    serial.pool = NULL;
+    serial.device = NULL;
+
+    size_t tasks = opts.pool != NULL ? min(sets, (size_t)opts.pool->size() * 4) : 1;
+    if( tasks <= 1 ) {
+
+        vector<coord>& out = threadStack();
+        for(size_t s=0; s<sets; s++) {
+            hullOffsets[s + 1] = batchHull(pts + offsets[s], offsets[s + 1] - offsets[s],
+                hulls.data() + offsets[s] - base, out, scratch, serial);
+        }
+
+    }
+    else {
+
+        taskGroup group(*opts.pool);
+        for(size_t t=0; t<tasks; t++) {
+
+            size_t begin = sets / tasks * t + (t < sets % tasks ? t : sets % tasks);
+            size_t end = begin + sets / tasks + (t < sets % tasks ? 1 : 0);
+
+            group.run([&, begin, end]{
+                hullScratch local;
+                vector<coord>& out = threadStack();
+                for(size_t s=begin; s<end; s++) {
+                    hullOffsets[s + 1] = batchHull(pts + offsets[s], offsets[s + 1] - offsets[s],
+                        hulls.data() + offsets[s] - base, out, local, serial);
+                }
+            });
+
+        }
+        group.wait();
+
+    }
+
+    // packing the hulls together, each one only moves towards the front
+    for(size_t s=0; s<sets; s++) {
+
+        size_t size = hullOffsets[s + 1];
+        size_t from = offsets[s] - base;
+        hullOffsets[s + 1] = hullOffsets[s] + size;
+        for(size_t i=0; i<size; i++) {
+            hulls[hullOffsets[s] + i] = hulls[from + i];
+        }
+
+    }
+    hulls.resize(hullOffsets[sets]);
+
+}
+
+/*request latencies in log-spaced buckets, eight per power of two, so recording is one atomic
+  increment and a percentile is read to within 1/8 of its value*/
+class latencyHistogram {
+
+public:
+
+    latencyHistogram() {
+
+        for(size_t i=0; i<bucketCount; i++) {
+            counts[i] = 0;
+        }
+
+    }
+
+    void record(unsigned long long us) {
+
+        counts[bucketOf(us)]++;
+
+    }
+
+    /*smallest bucket bound with at least a fraction q of the recorded latencies at or below it*/
+    unsigned long long percentile(double q) const {
+
+        unsigned long long total = 0;
+        for(size_t i=0; i<bucketCount; i++) {
+            total += counts[i];
+        }
+        if( total == 0 ) {
+            return 0;
+        }
+
+        unsigned long long want = (unsigned long long)ceil(q * total), seen = 0;
+        for(size_t i=0; i<bucketCount; i++) {
+            seen += counts[i];
+            if( seen >= want ) {
+                return upperBound(i);
+            }
+        }
+
+        return upperBound(bucketCount - 1);
+
+    }
+
+private:
+
+    static const size_t bucketCount = 64 * 8;
+
+    /*values below 8 get a bucket each, above that the top three bits below the leading one pick
+      one of eight buckets in its power of two*/
+    static size_t bucketOf(unsigned long long v) {
+
+        if( v < 8 ) {
+            return (size_t)v;
+        }
+
+        int top = 63 - __builtin_clzll(v);
+        return (size_t)(top - 2) * 8 + (size_t)((v >> (top - 3)) & 7);
+
+    }
+
+    static unsigned long long upperBound(size_t b) {
+
+        if( b < 8 ) {
+            return b;
+        }
+
+        int top = (int)(b / 8) + 2;
+        unsigned long long low = (1ULL << top) | ((unsigned long long)(b % 8) << (top - 3));
+        return low + (1ULL << (top - 3)) - 1;
+
+    }
+
+    atomic<unsigned long long> counts[bucketCount];
+
+};
+
+/*a hullService's counters at one moment, latencies in microseconds from submit to result*/
+struct hullServiceStats {
+
+    size_t queued = 0;          // submitted, not yet handed to the pool
+    size_t inFlight = 0;        // handed to the pool, no result yet
+    size_t completed = 0;
+    size_t batches = 0;         // computeHulls calls made for coalesced small requests
+    size_t batched = 0;         // requests that went through them
+    unsigned long long p50 = 0, p90 = 0, p99 = 0, p999 = 0;
+
+};
+
+/*long-lived asynchronous hull engine on a threadPool. submit() queues a point buffer and hands
+  back a future of its hull. A dispatcher thread drains the queue: requests of up to smallMax
+  points are coalesced into computeHulls batches of about batchPoints points, and every bigger
+  one runs as three pool tasks, ingestion (copy, angles, cull), sort and scan, so stages of
+  different requests overlap on the pool. Results match computeHull with the same options*/
+class hullService {
+
+public:
+
+    hullService(threadPool& pool, const hullOptions& opts = hullOptions(), size_t smallMax = 4096,
+        size_t batchPoints = (size_t)1 << 16) :
+        pool(pool), opts(opts), smallMax(smallMax), batchPoints(batchPoints), stopping(false),
+        waiting(0), running(0), completed(0), batches(0), batched(0) {
+
+        this->opts.pool = NULL;
+        this->opts.trace = NULL;
+        dispatcher = thread(&hullService::dispatchLoop, this);
+
+    }
+
+    /*finishes everything already submitted*/
+    ~hullService() {
+
+        {
+            lock_guard<mutex> hold(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        dispatcher.join();
+
+        while(running > 0) {
+            if( !pool.runPending() ) {
+                this_thread::yield();
+            }
+        }
+
+    }
+
+    /*pts must stay valid until the future is ready*/
+    future<vector<coord>> submit(const coord* pts, size_t n) {
+
+        shared_ptr<request> r = make_shared<request>();
+        r->src = pts;
+        r->n = r->live = n;
+        return enqueue(r);
+
+    }
+
+    /*the buffer moves into the service and is worked on in place*/
+    future<vector<coord>> submit(vector<coord>&& pts) {
+
+        shared_ptr<request> r = make_shared<request>();
+        r->work.swap(pts);
+        r->src = r->work.data();
+        r->n = r->live = r->work.size();
+        r->owned = true;
+        return enqueue(r);
+
+    }
+
+    /*requests waiting for the dispatcher*/
+    size_t queueDepth() const {
+
+        return waiting;
+
+    }
+
+    hullServiceStats stats() const {
+
+        hullServiceStats s;
+        s.queued = waiting;
+        s.inFlight = running;
+        s.completed = completed;
+        s.batches = batches;
+        s.batched = batched;
+        s.p50 = latency.percentile(0.5);
+        s.p90 = latency.percentile(0.9);
+        s.p99 = latency.percentile(0.99);
+        s.p999 = latency.percentile(0.999);
+        return s;
+
+    }
+
+private:
+
+    struct request {
+
+        const coord* src = NULL;
+        size_t n = 0;                       // points submitted
+        size_t live = 0;                    // points left after the cull
+        bool owned = false;
+        vector<coord> work, aux, out;
+        unsigned long long key = 0;
+        promise<vector<coord>> result;
+        chrono::steady_clock::time_point submitted;
+
+    };
+
+    typedef shared_ptr<request> requestPtr;
+
+    future<vector<coord>> enqueue(const requestPtr& r) {
+
+        future<vector<coord>> f = r->result.get_future();
+        r->submitted = chrono::steady_clock::now();
+        {
+            lock_guard<mutex> hold(lock);
+            queue.push_back(r);
+            waiting++;
+        }
+        wake.notify_one();
+        return f;
+
+    }
+
+    void dispatchLoop() {
+
+        deque<requestPtr> taken;
+        while(1) {
+
+            {
+                unique_lock<mutex> hold(lock);
+                wake.wait(hold, [this]{ return stopping || !queue.empty(); });
+                if( queue.empty() ) {
+                    return;
+                }
+                taken.swap(queue);
+            }
+
+            // whatever queued up while the last round was dispatched is one round now
+            vector<requestPtr> batch;
+            size_t points = 0;
+            for(size_t i=0; i<taken.size(); i++) {
+
+                requestPtr& r = taken[i];
+                running++;
+                waiting--;
+                if( r->n > smallMax ) {
+                    pool.submit([this, r]{ ingestStage(r); });
+                    continue;
+                }
+
+                batch.push_back(r);
+                points += r->n;
+                if( points >= batchPoints ) {
+                    submitBatch(batch);
+                    points = 0;
+                }
+
+            }
+            submitBatch(batch);
+            taken.clear();
+
+        }
+
+    }
+
+    void submitBatch(vector<requestPtr>& batch) {
+
+        if( batch.empty() ) {
+            return;
+        }
+
+        shared_ptr<vector<requestPtr>> sets = make_shared<vector<requestPtr>>();
+        sets->swap(batch);
+        pool.submit([this, sets]{ runBatch(*sets); });
+
+    }
+
+    /*the coalesced small requests through one computeHulls call; a throw fails every request
+      of the batch not handed out yet*/
+    void runBatch(vector<requestPtr>& sets) {
+
+        size_t done = 0;
+        try {
+
+            vector<coord> pts;
+            vector<size_t> offsets(1, 0);
+            for(size_t s=0; s<sets.size(); s++) {
+                pts.insert(pts.end(), sets[s]->src, sets[s]->src + sets[s]->n);
+                offsets.push_back(pts.size());
+            }
+
+            vector<coord> hulls;
+            vector<size_t> hullOffsets;
+            hullScratch scratch;
+            computeHulls(pts.data(), offsets.data(), sets.size(), hulls, hullOffsets, scratch, opts);
+            batches++;
+            batched += sets.size();
+
+            for(; done<sets.size(); done++) {
+                sets[done]->out.assign(hulls.begin() + hullOffsets[done],
+                    hulls.begin() + hullOffsets[done + 1]);
+                finish(sets[done], false);
+            }
+
+        }
+        catch(...) {
+            for(; done<sets.size(); done++) {
+                fail(sets[done]);
+            }
+        }
+
+    }
+
+    /*first stage: the points into the request's own buffer, then angles and the cull for Graham;
+      a cache hit ends the request here*/
+    void ingestStage(const requestPtr& r) {
+
+        try {
+
+            if( cachedHull(opts) ) {
+                r->key = hashPoints(r->src, r->n);
+                if( opts.cache->find(r->key, r->n, r->out) ) {
+                    finish(r, false);
+                    return;
+                }
+            }
+
+            if( !r->owned ) {
+                recycled(r->work);
+                r->work.assign(r->src, r->src + r->n);
+            }
+
+            if( opts.engine == GRAHAM_SCAN ) {
+
+                coord* work = r->work.data();
+                if( opts.sort == DELTA_SORT ) {
+                    findStart(work, r->n);
+                }
+                else {
+                    storeAngle(work, r->n);
+                }
+                r->live -= opts.cull ? cullInterior(work, r->n) : 0;
+
+            }
+
+            pool.submit([this, r]{ sortStage(r); });
+
+        }
+        catch(...) {
+            fail(r);
+        }
+
+    }
+
+    /*second stage: the angle sort, or the whole hull for the other engines*/
+    void sortStage(const requestPtr& r) {
+
+        try {
+
+            if( opts.engine != GRAHAM_SCAN ) {
+                hullScratch scratch;
+                hullInPlace(r->work.data(), r->n, r->out, scratch, opts);
+                finish(r, true);
+                return;
+            }
+
+            recycled(r->aux);
+            r->aux.resize(r->live);
+            angleSortWork(r->work.data(), r->live, r->aux.data(), opts);
+            pool.submit([this, r]{ scanStage(r); });
+
+        }
+        catch(...) {
+            fail(r);
+        }
+
+    }
+
+    void scanStage(const requestPtr& r) {
+
+        try {
+            scanSorted(r->work.data(), r->live, r->out);
+            finish(r, true);
+        }
+        catch(...) {
+            fail(r);
+        }
+
+    }
+
+    /*hands the hull to the future, storing it in the cache first when it was computed here*/
+    void finish(const requestPtr& r, bool store) {
+
+        if( store && cachedHull(opts) ) {
+            opts.cache->insert(r->key, r->n, r->out);
+        }
+
+        latency.record((unsigned long long)chrono::duration_cast<chrono::microseconds>(
+            chrono::steady_clock::now() - r->submitted).count());
+        recycle(r->aux);
+        if( !r->owned ) {
+            recycle(r->work);
+        }
+        // last, so nothing after it can throw and the promise is never satisfied twice
+        r->result.set_value(move(r->out));
+        completed++;
+        running--;
+
+    }
+
+    /*hands whatever a stage threw to the future instead, so the caller sees it on get() and
+      the destructor is not left waiting on the request*/
+    void fail(const requestPtr& r) {
+
+        r->result.set_exception(current_exception());
+        running--;
+
+    }
+
+    /*an emptied buffer from an earlier request, so big requests do not fault in fresh pages*/
+    void recycled(vector<coord>& v) {
+
+        lock_guard<mutex> hold(spareLock);
+        if( !spare.empty() ) {
+            v.swap(spare.back());
+            spare.pop_back();
+        }
+        v.clear();
+
+    }
+
+    void recycle(vector<coord>& v) {
+
+        if( v.capacity() == 0 ) {
+            return;
+        }
+
+        lock_guard<mutex> hold(spareLock);
+        if( spare.size() < 2 * (size_t)pool.size() + 2 ) {
+            spare.push_back(vector<coord>());
+            spare.back().swap(v);
+        }
+
+    }
+
+    threadPool& pool;
+    hullOptions opts;
+    size_t smallMax;
+    size_t batchPoints;
+
+    mutex lock;
+    condition_variable wake;
+    deque<requestPtr> queue;
+    bool stopping;
+    thread dispatcher;
+
+    mutex spareLock;
+    vector<vector<coord>> spare;
+
+    atomic<size_t> waiting;
+    atomic<size_t> running;
+    atomic<size_t> completed;
+    atomic<size_t> batches;
+    atomic<size_t> batched;
+    latencyHistogram latency;
+
+};
+
+/*online convex hull: the lower and upper chains sit in balanced trees keyed by x, so an
+  insert is O(log h) amortized; query() hands back the hull in computeHull's order*/
+class incrementalHull {
+
+public:
+
+    incrementalHull() : dirty(false) {}
+
+    /*adding a point, true when it became a hull vertex*/
+    bool insert(coord c) {
+
+        bool low = insertChain(lower, c.x, c.y);
+        bool high = insertChain(upper, c.x, -c.y);
+
+        if( low || high ) {
+            dirty = true;
+        }
+
+        return low || high;
+
+    }
+
+    /*the current hull, rebuilt from the chains only after it changed*/
+    const vector<coord>& query() {
+
+        if( dirty ) {
+            rebuild();
+            dirty = false;
+        }
+
+        return hull;
+
+    }
+
+    void clear() {
+
+        lower.clear();
+        upper.clear();
+        hull.clear();
+        dirty = false;
+
+    }
+
+private:
+
+    typedef map<int, int> chain;
+
+    /*keeping ch the strictly convex lower chain of everything inserted so far*/
+    static bool insertChain(chain& ch, int x, int y) {
+
+        chain::iterator same = ch.find(x);
+        if( same != ch.end() ) {
+
+            if( same->second <= y ) {
+                return false;
+            }
+            // lower than a vertex at the same x, so below the chain for sure
+            ch.erase(same);
+
+        }
+        else {
+
+            chain::iterator r = ch.lower_bound(x);
+            if( r != ch.end() && r != ch.begin() ) {
+                chain::iterator l = prev(r);
+                if( predicate<int>::orient(l->first, l->second, r->first, r->second, x, y) >= 0 ) {
+                    return false;
+                }
+            }
+
+        }
+
+        chain::iterator it = ch.insert(make_pair(x, y)).first;
+
+        // neighbours that no longer turn left drop out
+        while(1) {
+
+            chain::iterator r1 = next(it);
+            if( r1 == ch.end() || next(r1) == ch.end() ) {
+                break;
+            }
+            chain::iterator r2 = next(r1);
+            if( predicate<int>::orient(x, y, r1->first, r1->second, r2->first, r2->second) > 0 ) {
+                break;
+            }
+            ch.erase(r1);
+
+        }
+
+        while(it != ch.begin() && prev(it) != ch.begin()) {
+
+            chain::iterator l1 = prev(it);
+            chain::iterator l2 = prev(l1);
+            if( predicate<int>::orient(l2->first, l2->second, l1->first, l1->second, x, y) > 0 ) {
+                break;
+            }
+            ch.erase(l1);
+
+        }
+
+        return true;
+
+    }
+
+    void rebuild() {
+
+        hull.clear();
+        coord c = coord();
+
+        for(chain::iterator it = lower.begin(); it != lower.end(); it++) {
+            c.x = it->first;
+            c.y = it->second;
+            hull.push_back(c);
+        }
+
+        // upper chain right to left, its ends only where they differ from the lower chain's
+        for(chain::reverse_iterator it = upper.rbegin(); it != upper.rend(); it++) {
+
+            c.x = it->first;
+            c.y = -it->second;
+            bool end = it == upper.rbegin() || next(it) == upper.rend();
+            coord shared = it == upper.rbegin() ? hull.back() : hull.front();
+            if( end && shared.x == c.x && shared.y == c.y ) {
+                continue;
+            }
+            hull.push_back(c);
+
+        }
+
+        rotateToLowest(hull);
+
+    }
+
+    chain lower;
+    chain upper;            // y negated, so the upper chain is a lower chain too
+    vector<coord> hull;
+    bool dirty;
+
+};
+
+/*fully dynamic convex hull for sliding windows. Points sit in a treap ordered by (x, y), and every
+  treap node keeps the lower and upper chains of its subtree in persistent balanced trees: a node
+  builds its chains by cutting its children's at the bridge and joining the pieces, sharing
+  everything else. insert and erase rebuild the chains along one treap path, O(log^3 n) expected,
+  for O(n log n) memory*/
+class dynamicHull {
+
+public:
+
+    dynamicHull() : root(0), count(0), rng(0x9e3779b9u), dirty(false) {
+
+        // index 0 is the empty tree in both pools
+        nodes.resize(1);
+        chains.resize(1);
+
+    }
+
+    /*adding a point, a repeated point only bumps its count*/
+    void insert(coord c) {
+
+        count++;
+        dirty = true;
+
+        for(int t=root; t; ) {
+            if( nodes[t].p.x == c.x && nodes[t].p.y == c.y ) {
+                nodes[t].copies++;
+                return;
+            }
+            t = lexLess(c, nodes[t].p) ? nodes[t].left : nodes[t].right;
+        }
+
+        int v = allocNode();
+        nodes[v].p = c;
+        nodes[v].prio = rng();
+        nodes[v].copies = 1;
+        root = insertNode(root, v);
+
+    }
+
+    /*removing one copy of a point, false when it is not in the set*/
+    bool erase(coord c) {
+
+        int state = 0;
+        root = eraseNode(root, c, state);
+        if( state == 0 ) {
+            return false;
+        }
+
+        count--;
+        dirty = true;
+        return true;
+
+    }
+
+    /*the current hull in computeHull's order, rebuilt from the root chains only after a change*/
+    const vector<coord>& query() {
+
+        if( dirty ) {
+            rebuild();
+            dirty = false;
+        }
+
+        return hull;
+
+    }
+
+    /*points in the set, copies included*/
+    size_t size() const {
+
+        return count;
+
+    }
+
+    void clear() {
+
+        nodes.resize(1);
+        chains.resize(1);
+        freeNodes.clear();
+        freeChains.clear();
+        hull.clear();
+        root = 0;
+        count = 0;
+        dirty = false;
+
+    }
+
+private:
+
+    /*one vertex of a persistent chain; first is the leftmost point of the subtree*/
+    struct chainNode {
+
+        coord p;
+        coord first;
+        unsigned prio;
+        unsigned size;
+        int left;
+        int right;
+        int refs;
+
+    };
+
+    /*one distinct point of the set, owning the chains of its subtree*/
+    struct pointNode {
+
+        coord p;
+        unsigned prio;
+        unsigned copies;
+        int left;
+        int right;
+        int lower;          // lower chain, lexicographically smallest point to largest
+        int upper;          // upper chain of the negated points, so again a lower chain
+
+    };
+
+    static bool lexLess(coord a, coord b) {
+
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+
+    }
+
+    static int orient(coord a, coord b, coord c) {
+
+        return predicate<int>::orient(a.x, a.y, b.x, b.y, c.x, c.y);
+
+    }
+
+    unsigned chainSize(int t) const {
+
+        return t ? chains[t].size : 0;
+
+    }
+
+    void retain(int t) {
+
+        if( t ) {
+            chains[t].refs++;
+        }
+
+    }
+
+    void release(int t) {
+
+        vector<int>& stack = releaseStack;
+        stack.push_back(t);
+        while(!stack.empty()) {
+
+            int v = stack.back();
+            stack.pop_back();
+            if( v && --chains[v].refs == 0 ) {
+                stack.push_back(chains[v].left);
+                stack.push_back(chains[v].right);
+                freeChains.push_back(v);
+            }
+
+        }
+
+    }
+
+    /*a new chain node taking over the references to l and r*/
+    int makeChain(coord p, unsigned prio, int l, int r) {
+
+        int v;
+        if( freeChains.empty() ) {
+            v = (int)chains.size();
+            chains.push_back(chainNode());
+        }
+        else {
+            v = freeChains.back();
+            freeChains.pop_back();
+        }
+
+        chainNode& c = chains[v];
+        c.p = p;
+        c.first = l ? chains[l].first : p;
+        c.prio = prio;
+        c.size = 1 + chainSize(l) + chainSize(r);
+        c.left = l;
+        c.right = r;
+        c.refs = 1;
+        return v;
+
+    }
+
+    /*the first k vertices of t, as a new reference*/
+    int take(int t, unsigned k) {
+
+        if( t == 0 || k == 0 ) {
+            return 0;
+        }
+        if( k >= chains[t].size ) {
+            retain(t);
+            return t;
+        }
+
+        int l = chains[t].left;
+        int r = chains[t].right;
+        unsigned ls = chainSize(l);
+        if( k <= ls ) {
+            return take(l, k);
+        }
+
+        retain(l);
+        int right = take(r, k - ls - 1);
+        return makeChain(chains[t].p, chains[t].prio, l, right);
+
+    }
+
+    /*t without its first k vertices, as a new reference*/
+    int drop(int t, unsigned k) {
+
+        if( t == 0 || k >= chains[t].size ) {
+            return 0;
+        }
+        if( k == 0 ) {
+            retain(t);
+            return t;
+        }
+
+        int l = chains[t].left;
+        int r = chains[t].right;
+        unsigned ls = chainSize(l);
+        if( k > ls ) {
+            return drop(r, k - ls - 1);
+        }
+
+        retain(r);
+        int left = drop(l, k);
+        return makeChain(chains[t].p, chains[t].prio, left, r);
+
+    }
+
+    /*concatenating two chains, consuming both references*/
+    int join(int a, int b) {
+
+        if( a == 0 ) {
+            return b;
+        }
+        if( b == 0 ) {
+            return a;
+        }
+
+        if( chains[a].prio >= chains[b].prio ) {
+
+            chainNode c = chains[a];
+            retain(c.left);
+            retain(c.right);
+            release(a);
+            int right = join(c.right, b);
+            return makeChain(c.p, c.prio, c.left, right);
+
+        }
+
+        chainNode c = chains[b];
+        retain(c.left);
+        retain(c.right);
+        release(b);
+        int left = join(a, c.left);
+        return makeChain(c.p, c.prio, left, c.right);
+
+    }
+
+    /*index of the vertex of chain t touching from below the line to q, with q past its last
+      vertex: the first vertex whose next edge does not have q strictly to its left*/
+    unsigned tangent(int t, coord q, coord& touch) const {
+
+        unsigned base = 0, best = 0;
+        coord after = coord();
+        bool hasAfter = false;
+
+        while(t) {
+
+            const chainNode& v = chains[t];
+            bool hasNext = v.right != 0 || hasAfter;
+            coord next = v.right ? chains[v.right].first : after;
+            unsigned index = base + chainSize(v.left);
+
+            if( hasNext && orient(v.p, next, q) > 0 ) {
+                base = index + 1;
+                t = v.right;
+            }
+            else {
+                best = index;
+                touch = v.p;
+                after = v.p;
+                hasAfter = true;
+                t = v.left;
+            }
+
+        }
+
+        return best;
+
+    }
+
+    /*lower chain of two chains, every point of l before every point of r, as a new reference.
+      The bridge ends at the first vertex of r whose next edge has the tangent point from l
+      strictly to its left*/
+    int combine(int l, int r) {
+
+        if( l == 0 || r == 0 ) {
+            retain(l + r);
+            return l + r;
+        }
+
+        unsigned base = 0, bridgeL = 0, bridgeR = 0;
+        coord after = coord();
+        bool hasAfter = false;
+
+        for(int t=r; t; ) {
+
+            const chainNode& v = chains[t];
+            bool hasNext = v.right != 0 || hasAfter;
+            coord next = v.right ? chains[v.right].first : after;
+            unsigned index = base + chainSize(v.left);
+
+            coord touch = coord();
+            unsigned at = tangent(l, v.p, touch);
+            if( !hasNext || orient(v.p, next, touch) > 0 ) {
+                bridgeL = at;
+                bridgeR = index;
+                after = v.p;
+                hasAfter = true;
+                t = v.left;
+            }
+            else {
+                base = index + 1;
+                t = v.right;
+            }
+
+        }
+
+        return join(take(l, bridgeL + 1), drop(r, bridgeR));
+
+    }
+
+    int allocNode() {
+
+        if( freeNodes.empty() ) {
+            nodes.push_back(pointNode());
+            return (int)nodes.size() - 1;
+        }
+
+        int v = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[v] = pointNode();
+        return v;
+
+    }
+
+    /*rebuilding the chains of v from its children's*/
+    void pull(int v) {
+
+        pointNode& n = nodes[v];
+        coord neg = coord();
+        neg.x = -n.p.x;
+        neg.y = -n.p.y;
+
+        int leaf = makeChain(n.p, rng(), 0, 0);
+        int part = combine(nodes[n.left].lower, leaf);
+        release(leaf);
+        int lower = combine(part, nodes[n.right].lower);
+        release(part);
+
+        // negating reverses the order, so the right subtree comes first
+        leaf = makeChain(neg, rng(), 0, 0);
+        part = combine(nodes[n.right].upper, leaf);
+        release(leaf);
+        int upper = combine(part, nodes[n.left].upper);
+        release(part);
+
+        release(n.lower);
+        release(n.upper);
+        n.lower = lower;
+        n.upper = upper;
+
+    }
+
+    /*splitting treap t into the points before key and the rest*/
+    void splitNodes(int t, coord key, int& l, int& r) {
+
+        if( t == 0 ) {
+            l = r = 0;
+            return;
+        }
+
+        if( lexLess(nodes[t].p, key) ) {
+            splitNodes(nodes[t].right, key, nodes[t].right, r);
+            l = t;
+        }
+        else {
+            splitNodes(nodes[t].left, key, l, nodes[t].left);
+            r = t;
+        }
+        pull(t);
+
+    }
+
+    int mergeNodes(int a, int b) {
+
+        if( a == 0 || b == 0 ) {
+            return a + b;
+        }
+
+        if( nodes[a].prio > nodes[b].prio ) {
+            nodes[a].right = mergeNodes(nodes[a].right, b);
+            pull(a);
+            return a;
+        }
+
+        nodes[b].left = mergeNodes(a, nodes[b].left);
+        pull(b);
+        return b;
+
+    }
+
+    int insertNode(int t, int v) {
+
+        if( t == 0 ) {
+            pull(v);
+            return v;
+        }
+
+        if( nodes[v].prio > nodes[t].prio ) {
+            splitNodes(t, nodes[v].p, nodes[v].left, nodes[v].right);
+            pull(v);
+            return v;
+        }
+
+        if( lexLess(nodes[v].p, nodes[t].p) ) {
+            nodes[t].left = insertNode(nodes[t].left, v);
+        }
+        else {
+            nodes[t].right = insertNode(nodes[t].right, v);
+        }
+        pull(t);
+        return t;
+
+    }
+
+    /*state becomes 1 when a copy was dropped and 2 when the node itself went away*/
+    int eraseNode(int t, coord c, int& state) {
+
+        if( t == 0 ) {
+            return 0;
+        }
+
+        pointNode& n = nodes[t];
+        if( n.p.x == c.x && n.p.y == c.y ) {
+
+            if( --n.copies > 0 ) {
+                state = 1;
+                return t;
+            }
+
+            state = 2;
+            int merged = mergeNodes(n.left, n.right);
+            release(nodes[t].lower);
+            release(nodes[t].upper);
+            freeNodes.push_back(t);
+            return merged;
+
+        }
+
+        if( lexLess(c, n.p) ) {
+            nodes[t].left = eraseNode(n.left, c, state);
+        }
+        else {
+            nodes[t].right = eraseNode(n.right, c, state);
+        }
+
+        if( state == 2 ) {
+            pull(t);
+        }
+        return t;
+
+    }
+
+    /*in-order vertices of chain t, negated when asked*/
+    void appendChain(int t, bool negate, vector<coord>& out) const {
+
+        if( t == 0 ) {
+            return;
+        }
+
+        appendChain(chains[t].left, negate, out);
+        coord c = coord();
+        c.x = negate ? -chains[t].p.x : chains[t].p.x;
+        c.y = negate ? -chains[t].p.y : chains[t].p.y;
+        out.push_back(c);
+        appendChain(chains[t].right, negate, out);
+
+    }
+
+    void rebuild() {
+
+        hull.clear();
+        if( root == 0 ) {
+            return;
+        }
+
+        appendChain(nodes[root].lower, false, hull);
+
+        // the upper chain runs from the largest point back to the smallest, both already there
+        vector<coord>& upper = upperPoints;
+        upper.clear();
+        appendChain(nodes[root].upper, true, upper);
+        for(size_t i=1; i+1<upper.size(); i++) {
+            hull.push_back(upper[i]);
+        }
+
+        rotateToLowest(hull);
+
+    }
+
+    vector<pointNode> nodes;
+    vector<chainNode> chains;
+    vector<int> freeNodes;
+    vector<int> freeChains;
+    vector<int> releaseStack;
+    vector<coord> upperPoints;
+    vector<coord> hull;
+    int root;
+    size_t count;
+    minstd_rand rng;
+    bool dirty;
+
+};
+
+/*O(log h) queries against a hull as computeHull returns it: containment by binary search over
+  the fan of wedges at the first vertex, extreme points by binary search over the edge
+  directions, which turn counter-clockwise through one full circle*/
+class hullQuery {
+
+public:
+
+    explicit hullQuery(const vector<coord>& hull) : v(hull) {
+
+        size_t h = v.size();
+        xy.resize(2 * h);
+        ex.resize(h);
+        ey.resize(h);
+        fanBias.resize(h);
+        edgeBias.resize(h);
+
+        for(size_t i=0; i<h; i++) {
+
+            const coord& next = v[i + 1 < h ? i + 1 : 0];
+            xy[2 * i] = v[i].x;
+            xy[2 * i + 1] = v[i].y;
+            ex[i] = (long long)next.x - v[i].x;
+            ey[i] = (long long)next.y - v[i].y;
+            fanBias[i] = farthestBias(v[0].x, v[0].y, v[i].x, v[i].y);
+            edgeBias[i] = farthestBias(v[i].x, v[i].y, next.x, next.y);
+
+        }
+
+    }
+
+    size_t size() const {
+
+        return v.size();
+
+    }
+
+    const coord& vertex(size_t i) const {
+
+        return v[i];
+
+    }
+
+    /*whether p is inside the hull or on its boundary*/
+    bool contains(coord p) const {
+
+        size_t h = v.size();
+        if( h < 3 ) {
+            return onDegenerate(p);
+        }
+
+        unsigned char in;
+        insideFanScalar(fan(), &p.x, &p.y, 1, &in);
+        return in;
+
+    }
+
+    /*contains() for every (x[i], y[i]), several points per step on the SIMD kernels*/
+    void contains(const int* x, const int* y, size_t n, unsigned char* inside) const {
+
+        if( v.size() >= 3 ) {
+            simd().insideFan(fan(), x, y, n, inside);
+            return;
+        }
+
+        for(size_t i=0; i<n; i++) {
+            coord p = coord();
+            p.x = x[i];
+            p.y = y[i];
+            inside[i] = onDegenerate(p);
+        }
+
+    }
+
+    /*index of a vertex farthest in direction (dx, dy), the hull must not be empty; when an edge
+      is square to the direction its first vertex counter-clockwise is picked. It is where the
+      direction turned left by 90 degrees falls between the incoming and outgoing edge*/
+    size_t extreme(long long dx, long long dy) const {
+
+        size_t h = v.size();
+        if( h < 2 ) {
+            return 0;
+        }
+
+        // first edge turned at least as far from edge 0 as (-dy, dx)
+        long long tx = -dy, ty = dx;
+        size_t lo = 0, hi = h;
+        while(lo < hi) {
+
+            size_t mid = lo + (hi - lo) / 2;
+            if( turnedBefore(ex[mid], ey[mid], tx, ty) ) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+
+        }
+
+        return lo == h ? 0 : lo;
+
+    }
+
+private:
+
+    fanTable fan() const {
+
+        return {xy.data(), fanBias.data(), edgeBias.data(), v.size()};
+
+    }
+
+    /*containment for hulls of one point or one segment*/
+    bool onDegenerate(coord p) const {
+
+        if( v.empty() ) {
+            return false;
+        }
+        if( v.size() == 1 ) {
+            return p.x == v[0].x && p.y == v[0].y;
+        }
+
+        const coord& a = v[0];
+        const coord& b = v[1];
+        return predicate<int>::orient(a.x, a.y, b.x, b.y, p.x, p.y) == 0 &&
+            min(a.x, b.x) <= p.x && p.x <= max(a.x, b.x) && min(a.y, b.y) <= p.y && p.y <= max(a.y, b.y);
+
+    }
+
+    /*0 for directions in [0, 180) degrees counter-clockwise from edge 0, 1 for [180, 360)*/
+    int half(long long ux, long long uy) const {
+
+        int c = predicate<long long>::cross(ex[0], ey[0], ux, uy);
+        __int128 dot = (__int128)ex[0] * ux + (__int128)ey[0] * uy;
+        return !(c > 0 || (c == 0 && dot > 0));
+
+    }
+
+    /*whether u is turned less far from edge 0 than t*/
+    bool turnedBefore(long long ux, long long uy, long long tx, long long ty) const {
+
+        int hu = half(ux, uy), ht = half(tx, ty);
+        if( hu != ht ) {
+            return hu < ht;
+        }
+
+        return predicate<long long>::cross(ux, uy, tx, ty) > 0;
+
+    }
+
+    vector<coord> v;
+    vector<int> xy;
+    vector<long long> ex, ey;
+    vector<long long> fanBias, edgeBias;
+
+};
+
+/*a rectangle enclosing a hull with one side along hull edge `edge`: corners counter-clockwise,
+  the first two on that edge's line*/
+struct hullRect {
+
+    double corner[4][2];
+    double area;
+    double perimeter;
+    size_t edge;
+
+};
+
+/*rotating-calipers measures of one hull: the farthest vertex pair with its squared distance,
+  the narrowest strip with its edge and the vertex on the far side, and the smallest rectangles
+  by area and by perimeter. Indices are into the hull*/
+struct hullCalipers {
+
+    size_t diameterA, diameterB;
+    unsigned long long diameter2;
+    double width;
+    size_t widthEdge, widthVertex;
+    hullRect minArea, minPerimeter;
+
+};
+
+/*(b - a) . (d - c) and (b - a) x (d - c) for hull vertices, exact for 32-bit coordinates*/
+__int128 caliperDot(coord a, coord b, coord c, coord d) {
+
+    return (__int128)((long long)b.x - a.x) * ((long long)d.x - c.x) +
+        (__int128)((long long)b.y - a.y) * ((long long)d.y - c.y);
+
+}
+
+__int128 caliperCross(coord a, coord b, coord c, coord d) {
+
+    return (__int128)((long long)b.x - a.x) * ((long long)d.y - c.y) -
+        (__int128)((long long)b.y - a.y) * ((long long)d.x - c.x);
+
+}
+
+unsigned long long distance2(coord a, coord b) {
+
+    long long dx = (long long)b.x - a.x, dy = (long long)b.y - a.y;
+    return (unsigned long long)(dx * dx) + (unsigned long long)(dy * dy);
+
+}
+
+/*the rectangle on edge a -> b spanning projections [low, high] along it and `height` across,
+  all three scaled by the edge's squared length*/
+hullRect edgeRect(coord a, coord b, size_t edge, double low, double high, double height) {
+
+    double ex = (double)b.x - a.x, ey = (double)b.y - a.y;
+    double len2 = ex * ex + ey * ey;
+    double from = low / len2, to = high / len2, up = height / len2;
+
+    hullRect r;
+    r.corner[0][0] = a.x + ex * from;
+    r.corner[0][1] = a.y + ey * from;
+    r.corner[1][0] = a.x + ex * to;
+    r.corner[1][1] = a.y + ey * to;
+    r.corner[2][0] = a.x + ex * to - ey * up;
+    r.corner[2][1] = a.y + ey * to + ex * up;
+    r.corner[3][0] = a.x + ex * from - ey * up;
+    r.corner[3][1] = a.y + ey * from + ex * up;
+    r.area = (high - low) * height / len2;
+    r.perimeter = 2 * (high - low + height) / sqrt(len2);
+    r.edge = edge;
+    return r;
+
+}
+
+/*calipers of a hull in computeHull's order in O(h): for each edge in turn, three pointers
+  advance round the hull to the vertex farthest from the edge and to the two extremes along it,
+  and none of them ever moves back. Diameter, width and both rectangles are read off per edge*/
+hullCalipers calipers(const coord* v, size_t h) {
+
+    hullCalipers c = hullCalipers();
+    if( h < 2 ) {
+
+        for(int k=0; k<4 && h == 1; k++) {
+            c.minArea.corner[k][0] = v[0].x;
+            c.minArea.corner[k][1] = v[0].y;
+        }
+        c.minPerimeter = c.minArea;
+        return c;
+
+    }
+
+    // the pointers only ever run up to twice round the hull
+    auto at = [&](size_t k) { return v[k < h ? k : (k < 2 * h ? k - h : k - 2 * h)]; };
+
+    c.width = HUGE_VAL;
+    c.minArea.area = HUGE_VAL;
+    c.minPerimeter.perimeter = HUGE_VAL;
+
+    size_t top = 1, right = 1, left = 0;
+    for(size_t i=0; i<h; i++) {
+
+        coord a = v[i], b = at(i + 1);
+
+        // pointers start no earlier than the edge's own end
+        if( top < i + 1 ) {
+            top = i + 1;
+        }
+        if( right < i + 1 ) {
+            right = i + 1;
+        }
+        while(caliperCross(a, b, at(top), at(top + 1)) > 0) {
+            top++;
+        }
+        while(caliperDot(a, b, at(right), at(right + 1)) > 0) {
+            right++;
+        }
+        if( i == 0 ) {
+            left = top;
+        }
+        while(caliperDot(a, b, at(left), at(left + 1)) < 0) {
+            left++;
+        }
+
+        // the farthest pair is antipodal: an edge end against the farthest vertex, or the
+        // vertex after it when that one lies on a parallel edge
+        coord t = at(top);
+        bool parallel = caliperCross(a, b, t, at(top + 1)) == 0;
+        size_t ends[2] = {i, (i + 1) % h};
+        for(size_t e=0; e<2; e++) {
+            for(size_t s=0; s<(parallel ? 2u : 1u); s++) {
+
+                unsigned long long d = distance2(v[ends[e]], at(top + s));
+                if( d > c.diameter2 ) {
+                    c.diameter2 = d;
+                    c.diameterA = ends[e];
+                    c.diameterB = (top + s) % h;
+                }
+
+            }
+        }
+
+        // the exact values are rounded once; the corners are only worked out for a new best
+        double height = (double)caliperCross(a, b, a, t);
+        double low = (double)caliperDot(a, b, a, at(left)), high = (double)caliperDot(a, b, a, at(right));
+        double len2 = (double)distance2(a, b), len = sqrt(len2);
+        double width = height / len;
+        if( width < c.width ) {
+            c.width = width;
+            c.widthEdge = i;
+            c.widthVertex = top % h;
+        }
+
+        if( (high - low) * height / len2 < c.minArea.area ) {
+            c.minArea = edgeRect(a, b, i, low, high, height);
+        }
+        if( 2 * (high - low + height) / len < c.minPerimeter.perimeter ) {
+            c.minPerimeter = edgeRect(a, b, i, low, high, height);
+        }
+
+    }
+
+    return c;
+
+}
+
+/*calipers() of every hull in computeHulls' layout, hull s at hulls[hullOffsets[s],
+  hullOffsets[s + 1]); with a pool the hulls are shared out over it*/
+void calipers(const coord* hulls, const size_t* hullOffsets, size_t sets, vector<hullCalipers>& out,
+    threadPool* pool = NULL) {
+
+    out.resize(sets);
+
+    size_t tasks = pool != NULL ? min(sets, (size_t)pool->size() * 4) : 1;
+    if( tasks <= 1 ) {
+
+        for(size_t s=0; s<sets; s++) {
+            out[s] = calipers(hulls + hullOffsets[s], hullOffsets[s + 1] - hullOffsets[s]);
+        }
+        return;
+
+    }
+
+    taskGroup group(*pool);
+    for(size_t t=0; t<tasks; t++) {
+
+        size_t begin = chunkBegin(sets, tasks, t), end = chunkBegin(sets, tasks, t + 1);
+        group.run([&, begin, end]{
+            for(size_t s=begin; s<end; s++) {
+                out[s] = calipers(hulls + hullOffsets[s], hullOffsets[s + 1] - hullOffsets[s]);
+            }
+        });
+
+    }
+    group.wait();
+
+}
+
+/*point file formats: "x y" / "x,y" text lines, or packed native-endian (x, y) pairs*/
+enum pointFormat {
+
+    TEXT_POINTS,
+    INT32_PAIRS,
+    INT64_PAIRS,
+    DOUBLE_PAIRS
+
+};
+
+/*largest |coordinate| accepted: below 2^30, so findAngle's differences fit an int and
+  predicate<int> stays exact*/
+const long long maxCoordinate = (1ll << 30) - 1;
+
+/*bytes of one (x, y) pair*/
+size_t pairBytes(pointFormat format) {
+
+    return format == INT32_PAIRS ? 2 * sizeof(int) : 2 * sizeof(long long);
+
+}
+
+/*a file's bytes, memory-mapped for regular files and read in for pipes*/
+struct inputBytes {
+
+    const char* data = NULL;
+    size_t size = 0;
+    void* mapped = NULL;
+    vector<char> owned;
+
+    ~inputBytes() {
+
+        if( mapped != NULL ) {
+            munmap(mapped, size);
+        }
+
+    }
+
+};
+
+/*opening path ("-" is stdin) for reading, returns the descriptor or -1*/
+int openInput(const char* path, string& error) {
+
+    if( strcmp(path, "-") == 0 ) {
+        return 0;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if( fd < 0 ) {
+        error = string("cannot open ") + path + ": " + strerror(errno);
+    }
+
+    return fd;
+
+}
+
+bool mapInput(const char* path, inputBytes& in, string& error) {
+
+    int fd = openInput(path, error);
+    if( fd < 0 ) {
+        return false;
+    }
+
+    struct stat st;
+    if( fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 ) {
+
+        void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if( p != MAP_FAILED ) {
+            madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+            in.mapped = p;
+            in.data = (const char*)p;
+            in.size = (size_t)st.st_size;
+            if( fd != 0 ) {
+                close(fd);
+            }
+            return true;
+        }
+
+    }
+
+    // pipes and anything else that will not map
+    const size_t block = (size_t)1 << 20;
+    size_t used = 0;
+    while(1) {
+
+        in.owned.resize(used + block);
+        ssize_t got = read(fd, in.owned.data() + used, block);
+        if( got < 0 && errno == EINTR ) {
+            continue;
+        }
+        if( got < 0 ) {
+            error = string("cannot read ") + path + ": " + strerror(errno);
+            if( fd != 0 ) {
+                close(fd);
+            }
+            return false;
+        }
+        if( got == 0 ) {
+            break;
+        }
+        used += (size_t)got;
+
+    }
+
+    in.owned.resize(used);
+    in.data = in.owned.data();
+    in.size = used;
+    if( fd != 0 ) {
+        close(fd);
+    }
+
+    return true;
+
+}
+
+/*every value of a packed binary buffer must be an integer the engines handle exactly; first is
+  the index of its first point in the input, for the message*/
+bool checkBinary(const char* data, size_t count, pointFormat format, string& error, size_t first = 0) {
+
+    for(size_t i=0; i<2 * count; i++) {
+
+        bool ok;
+        if( format == INT32_PAIRS ) {
+            int v;
+            memcpy(&v, data + i * sizeof(int), sizeof(int));
+            ok = v >= -maxCoordinate && v <= maxCoordinate;
+        }
+        else if( format == INT64_PAIRS ) {
+            long long v;
+            memcpy(&v, data + i * sizeof(long long), sizeof(long long));
+            ok = v >= -maxCoordinate && v <= maxCoordinate;
+        }
+        else {
+            double v;
+            memcpy(&v, data + i * sizeof(double), sizeof(double));
+            ok = v >= -maxCoordinate && v <= maxCoordinate && v == (double)(long long)v;
+        }
+
+        if( !ok ) {
+            error = "point " + to_string(first + i / 2) + ": coordinate is not an integer within +-(2^30 - 1)";
+            return false;
+        }
+
+    }
+
+    return true;
+
+}
+
+/*loader that converts packed pairs straight into the engine's buffer*/
+pointLoader binaryLoader(const char* data, pointFormat format) {
+
+    return [data, format](size_t b, size_t e, coord* dst) {
+
+        if( format == INT32_PAIRS ) {
+            for(size_t i=b; i<e; i++) {
+                int v[2];
+                memcpy(v, data + i * sizeof(v), sizeof(v));
+                dst[i - b].x = v[0];
+                dst[i - b].y = v[1];
+            }
+        }
+        else if( format == INT64_PAIRS ) {
+            for(size_t i=b; i<e; i++) {
+                long long v[2];
+                memcpy(v, data + i * sizeof(v), sizeof(v));
+                dst[i - b].x = (int)v[0];
+                dst[i - b].y = (int)v[1];
+            }
+        }
+        else {
+            for(size_t i=b; i<e; i++) {
+                double v[2];
+                memcpy(v, data + i * sizeof(v), sizeof(v));
+                dst[i - b].x = (int)v[0];
+                dst[i - b].y = (int)v[1];
+            }
+        }
+
+    };
+
+}
+
+/*parsing a signed integer at p, false when there is none or it is out of range*/
+bool parseCoordinate(const char*& p, const char* end, int& value) {
+
+    bool negative = false;
+    if( p < end && (*p == '-' || *p == '+') ) {
+        negative = *p == '-';
+        p++;
+    }
+
+    const char* digits = p;
+    long long v = 0;
+    while(p < end && (unsigned)(*p - '0') < 10) {
+        v = v * 10 + (*p - '0');
+        if( v > maxCoordinate ) {
+            return false;
+        }
+        p++;
+    }
+
+    // "12.000" is still an integer
+    if( p < end && *p == '.' ) {
+        p++;
+        while(p < end && *p == '0') {
+            p++;
+        }
+        if( p < end && (unsigned)(*p - '0') < 10 ) {
+            return false;
+        }
+    }
+
+    value = (int)(negative ? -v : v);
+    return p != digits;
+
+}
+
+/*appending the points of the text lines in [p, end) to pts, line counts lines seen so far;
+  blank lines, # comments and a first line without any digit are skipped. A point is "x y",
+  "x,y" or the "(x, y)" that writePoints prints*/
+bool parseTextLines(const char* p, const char* end, vector<coord>& pts, size_t& line, string& error) {
+
+    while(p < end) {
+
+        const char* eol = (const char*)memchr(p, '\n', end - p);
+        if( eol == NULL ) {
+            eol = end;
+        }
+        line++;
+
+        while(p < eol && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            p++;
+        }
+
+        bool header = false;
+        for(const char* q=p; line == 1 && q < eol && !header; q++) {
+            header = (unsigned)(*q - '0') < 10;
+        }
+        header = line == 1 && !header;
+
+        if( p < eol && *p != '#' && !header ) {
+
+            bool paren = *p == '(';
+            if( paren ) {
+                p++;
+                while(p < eol && (*p == ' ' || *p == '\t')) {
+                    p++;
+                }
+            }
+
+            coord c = coord();
+            bool ok = parseCoordinate(p, eol, c.x);
+            while(ok && p < eol && (*p == ' ' || *p == '\t' || *p == ',' || *p == ';')) {
+                p++;
+            }
+            ok = ok && parseCoordinate(p, eol, c.y);
+            while(ok && p < eol && (*p == ' ' || *p == '\t')) {
+                p++;
+            }
+            if( ok && paren ) {
+                ok = p < eol && *p == ')';
+                p += ok;
+            }
+            while(ok && p < eol && (*p == ' ' || *p == '\t' || *p == '\r' || *p == ',')) {
+                p++;
+            }
+
+            if( !ok || p != eol ) {
+                error = "line " + to_string(line) + ": expected two integers within +-(2^30 - 1)";
+                return false;
+            }
+            pts.push_back(c);
+
+        }
+
+        p = eol + 1;
+
+    }
+
+    return true;
+
+}
+
+/*a point file ("-" is stdin) read through read(2) a chunk at a time, so only one chunk of
+  points and one block of bytes are held whatever the file size*/
+class pointStream {
+
+public:
+
+    pointStream(pointFormat format, size_t chunkPoints) : fd(-1), format(format), chunk(chunkPoints),
+        carry(0), line(0), seen(0), done(false) {
+
+        if( chunk == 0 ) {
+            chunk = 1;
+        }
+
+    }
+
+    ~pointStream() {
+
+        if( fd > 0 ) {
+            close(fd);
+        }
+
+    }
+
+    bool open(const char* file, string& error) {
+
+        path = file;
+        fd = openInput(file, error);
+        return fd >= 0;
+
+    }
+
+    /*replacing pts with the next chunk, which is empty once the input is used up; text chunks
+      stop at the first whole line past chunkPoints points*/
+    bool next(vector<coord>& pts, string& error) {
+
+        pts.clear();
+        return format == TEXT_POINTS ? nextText(pts, error) : nextBinary(pts, error);
+
+    }
+
+private:
+
+    static const size_t block = (size_t)1 << 20;
+
+    /*read(2) of up to n bytes at dst, retrying interrupts; -1 with error set on failure*/
+    ssize_t readSome(char* dst, size_t n, string& error) {
+
+        while(1) {
+
+            ssize_t got = read(fd, dst, n);
+            if( got < 0 && errno == EINTR ) {
+                continue;
+            }
+            if( got < 0 ) {
+                error = "cannot read " + path + ": " + strerror(errno);
+            }
+            return got;
+
+        }
+
+    }
+
+    bool nextText(vector<coord>& pts, string& error) {
+
+        while(!done && pts.size() < chunk) {
+
+            if( buf.size() < carry + block ) {
+                buf.resize(carry + block);
+            }
+
+            ssize_t got = readSome(buf.data() + carry, block, error);
+            if( got < 0 ) {
+                return false;
+            }
+
+            size_t filled = carry + (size_t)got;
+            if( got == 0 ) {
+                done = true;
+                carry = 0;
+                return parseTextLines(buf.data(), buf.data() + filled, pts, line, error);
+            }
+
+            // complete lines now, the partial last line waits for the next block
+            const char* last = (const char*)memrchr(buf.data(), '\n', filled);
+            if( last == NULL ) {
+                carry = filled;
+                continue;
+            }
+
+            size_t used = last + 1 - buf.data();
+            if( !parseTextLines(buf.data(), last + 1, pts, line, error) ) {
+                return false;
+            }
+            carry = filled - used;
+            memmove(buf.data(), buf.data() + used, carry);
+
+        }
+
+        return true;
+
+    }
+
+    bool nextBinary(vector<coord>& pts, string& error) {
+
+        size_t pair = pairBytes(format);
+        size_t want = chunk * pair;
+        if( buf.size() < want ) {
+            buf.resize(want);
+        }
+
+        // the tail of a partial pair from the last read is still at the front
+        size_t filled = carry;
+        while(!done && filled < want) {
+
+            ssize_t got = readSome(buf.data() + filled, want - filled, error);
+            if( got < 0 ) {
+                return false;
+            }
+            done = got == 0;
+            filled += (size_t)got;
+
+        }
+
+        size_t count = filled / pair;
+        carry = filled - count * pair;
+        if( done && carry != 0 ) {
+            error = path + ": size is not a whole number of points";
+            return false;
+        }
+
+        if( !checkBinary(buf.data(), count, format, error, seen) ) {
+            return false;
+        }
+
+        pts.resize(count);
+        binaryLoader(buf.data(), format)(0, count, pts.data());
+        memmove(buf.data(), buf.data() + count * pair, carry);
+        seen += count;
+
+        return true;
+
+    }
+
+    int fd;
+    pointFormat format;
+    size_t chunk;
+    string path;
+    vector<char> buf;
+    size_t carry;   // bytes of an unfinished line or pair kept at the front of buf
+    size_t line;
+    size_t seen;    // binary points handed out so far
+    bool done;
+
+};
+
+/*streaming text points from path ("-" is stdin) into pts, one block of input at a time*/
+bool readTextPoints(const char* path, vector<coord>& pts, string& error) {
+
+    pointStream stream(TEXT_POINTS, SIZE_MAX);
+    return stream.open(path, error) && stream.next(pts, error);
+
+}
+
+/*hull of points parsed into work, which the serial engines reorder in place*/
+void hullOfParsed(vector<coord>& work, vector<coord>& out, hullScratch& scratch, const hullOptions& opts) {
+
+    if( work.empty() ) {
+        out.clear();
+        scratch.culled = 0;
+    }
+    else if( opts.pool == NULL && (opts.device == NULL || work.size() < opts.offloadMin) ) {
+        hullInPlace(work.data(), work.size(), out, scratch, opts);
+    }
+    else {
+        computeHull(work.data(), work.size(), out, scratch, opts);
+    }
+
+}
+
+/*hull of a point file that need not fit in memory: each chunk goes through the engine together
+  with the hull so far, which holds every vertex of the points before it, so the result is the
+  same as the in-memory hull. The next chunk is read on its own thread meanwhile, so memory stays
+  at two chunks plus the hull*/
+bool streamHull(const char* path, pointFormat format, size_t chunkPoints, vector<coord>& out,
+    hullScratch& scratch, const hullOptions& opts, string& error) {
+
+    out.clear();
+    pointStream stream(format, chunkPoints);
+    vector<coord> work, next;
+
+    // a chunk with the hull so far is no simple polygon, Melkman input streams through the chain
+    hullOptions chunkOpts = opts;
+    if( opts.engine == MELKMAN_HULL ) {
+        chunkOpts.engine = MONOTONE_CHAIN;
+    }
+    if( !stream.open(path, error) || !stream.next(next, error) ) {
+        return false;
+    }
+
+    while(!next.empty()) {
+
+        work.swap(next);
+        work.insert(work.end(), out.begin(), out.end());
+
+        bool ok = true;
+        string readError;
+        thread reader([&]{
+            ok = stream.next(next, readError);
+        });
+        hullOfParsed(work, out, scratch, chunkOpts);
+        reader.join();
+
+        if( !ok ) {
+            error = readError;
+            return false;
+        }
+
+    }
+
+    return true;
+
+}
+
+/*hull of a point file ("-" reads stdin); false with error set when it cannot be read*/
+bool computeHull(const char* path, pointFormat format, vector<coord>& out, hullScratch& scratch,
+    const hullOptions& opts, string& error) {
+
+    if( format == TEXT_POINTS ) {
+
+        if( !readTextPoints(path, scratch.work, error) ) {
+            return false;
+        }
+
+        hullOfParsed(scratch.work, out, scratch, opts);
+        return true;
+
+    }
+
+    inputBytes in;
+    if( !mapInput(path, in, error) ) {
+        return false;
+    }
+
+    if( in.size % pairBytes(format) != 0 ) {
+        error = string(path) + ": size is not a whole number of points";
+        return false;
+    }
+
+    size_t n = in.size / pairBytes(format);
+    if( !checkBinary(in.data, n, format, error) ) {
+        return false;
+    }
+
+    hullOfLoader(n, binaryLoader(in.data, format), out, scratch, opts);
+    return true;
+
+}
+
+/*bulk result writer: formats into one large buffer and hands it to write(2) only when full*/
+class resultWriter {
+
+public:
+
+    explicit resultWriter(int fd, size_t capacity = (size_t)1 << 20) : fd(fd), buf(capacity), used(0), ok(true) {}
+
+    ~resultWriter() {
+
+        flush();
+
+    }
+
+    void bytes(const char* p, size_t n) {
+
+        if( used + n > buf.size() ) {
+            flush();
+            if( n > buf.size() ) {
+                writeAll(p, n);
+                return;
+            }
+        }
+
+        memcpy(buf.data() + used, p, n);
+        used += n;
+
+    }
+
+    void text(const char* s) {
+
+        bytes(s, strlen(s));
+
+    }
+
+    /*decimal text, two digits per table lookup*/
+    void integer(long long v) {
+
+        static const char pairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        char tmp[24];
+        char* p = tmp + sizeof(tmp);
+        unsigned long long u = v < 0 ? 0 - (unsigned long long)v : (unsigned long long)v;
+
+        while(u >= 100) {
+            unsigned d = (unsigned)(u % 100) * 2;
+            u /= 100;
+            *--p = pairs[d + 1];
+            *--p = pairs[d];
+        }
+        if( u >= 10 ) {
+            unsigned d = (unsigned)u * 2;
+            *--p = pairs[d + 1];
+            *--p = pairs[d];
+        }
+        else {
+            *--p = (char)('0' + u);
+        }
+        if( v < 0 ) {
+            *--p = '-';
+        }
+
+        bytes(p, tmp + sizeof(tmp) - p);
+
+    }
+
+    void flush() {
+
+        writeAll(buf.data(), used);
+        used = 0;
+
+    }
+
+    /*false once any write has failed*/
+    bool good() const {
+
+        return ok;
+
+    }
+
+private:
+
+    void writeAll(const char* p, size_t n) {
+
+        while(ok && n > 0) {
+
+            ssize_t put = write(fd, p, n);
+            if( put < 0 && errno == EINTR ) {
+                continue;
+            }
+            if( put <= 0 ) {
+                ok = false;
+                break;
+            }
+            p += put;
+            n -= (size_t)put;
+
+        }
+
+    }
+
+    int fd;
+    vector<char> buf;
+    size_t used;
+    bool ok;
+
+};
+
+/*writing points as "(x, y)" lines, or as packed pairs of a binary input format*/
+void writePoints(resultWriter& w, const coord* pts, size_t n, pointFormat format) {
+
+    for(size_t i=0; i<n; i++) {
+
+        if( format == TEXT_POINTS ) {
+            w.bytes("(", 1);
+            w.integer(pts[i].x);
+            w.bytes(", ", 2);
+            w.integer(pts[i].y);
+            w.bytes(")\n", 2);
+        }
+        else if( format == INT32_PAIRS ) {
+            int v[2] = {pts[i].x, pts[i].y};
+            w.bytes((const char*)v, sizeof(v));
+        }
+        else if( format == INT64_PAIRS ) {
+            long long v[2] = {pts[i].x, pts[i].y};
+            w.bytes((const char*)v, sizeof(v));
+        }
+        else {
+            double v[2] = {(double)pts[i].x, (double)pts[i].y};
+            w.bytes((const char*)v, sizeof(v));
+        }
+
+    }
+
+}
+
+/*calipers() results as text lines after a printed hull*/
+void writeCalipers(resultWriter& w, const coord* hull, size_t h) {
+
+    if( h == 0 ) {
+        return;
+    }
+
+    hullCalipers c = calipers(hull, h);
+    const hullRect* rects[2] = {&c.minArea, &c.minPerimeter};
+    const char* names[2] = {"Minimum-area rectangle", "Minimum-perimeter rectangle"};
+    char line[256];
+
+    snprintf(line, sizeof(line), "\nDiameter: %.17g between (%d, %d) and (%d, %d)\n", sqrt((double)c.diameter2),
+        hull[c.diameterA].x, hull[c.diameterA].y, hull[c.diameterB].x, hull[c.diameterB].y);
+    w.text(line);
+    snprintf(line, sizeof(line), "Width: %.17g\n", c.width);
+    w.text(line);
+
+    for(int k=0; k<2; k++) {
+
+        snprintf(line, sizeof(line), "%s: area %.17g, perimeter %.17g, corners", names[k], rects[k]->area,
+            rects[k]->perimeter);
+        w.text(line);
+        for(int i=0; i<4; i++) {
+            snprintf(line, sizeof(line), " (%.17g, %.17g)", rects[k]->corner[i][0], rects[k]->corner[i][1]);
+            w.text(line);
+        }
+        w.text("\n");
+
+    }
+
+}
+
+/*format named on the command line, text for anything unknown*/
+pointFormat formatByName(const string& name) {
+
+    if( name == "int32" ) {
+        return INT32_PAIRS;
+    }
+    if( name == "int64" ) {
+        return INT64_PAIRS;
+    }
+    if( name == "double" ) {
+        return DOUBLE_PAIRS;
+    }
+
+    return TEXT_POINTS;
+
+}
+
+/*benchmark input distributions*/
+enum pointDistribution {
+
+    UNIFORM_SQUARE,
+    UNIFORM_DISK,
+    ON_CIRCLE,
+    GAUSSIAN,
+    CLUSTERED,              // tight gaussian blobs around a few centres
+    COLLINEAR_DUPLICATES    // few distinct points on a handful of lines, one a hull edge
+
+};
+
+const char* distributionName(pointDistribution dist) {
+
+    switch(dist) {
+        case UNIFORM_SQUARE: return "uniform-square";
+        case UNIFORM_DISK: return "uniform-disk";
+        case ON_CIRCLE: return "on-circle";
+        case GAUSSIAN: return "gaussian";
+        case CLUSTERED: return "clustered";
+        default: return "collinear-duplicates";
+    }
+
+}
+
+/*n points of the given distribution, inside the exact range of predicate<int> and narrow
+  enough for the radix angle sort's 64-bit keys*/
+void generatePoints(pointDistribution dist, size_t n, unsigned seed, vector<coord>& pts) {
+
+    const double radius = 5e8;
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> unit(-1.0, 1.0);
+    normal_distribution<double> normal(0.0, radius / 3);
+    normal_distribution<double> blob(0.0, radius / 50);
+
+    double centres[16][2];
+    for(int c=0; c<16; c++) {
+        centres[c][0] = unit(rng) * radius * 0.8;
+        centres[c][1] = unit(rng) * radius * 0.8;
+    }
+
+    pts.assign(n, coord());
+    for(size_t i=0; i<n; i++) {
+
+        double x, y;
+        if( dist == UNIFORM_SQUARE ) {
+            x = unit(rng) * radius;
+            y = unit(rng) * radius;
+        }
+        else if( dist == UNIFORM_DISK ) {
+            do {
+                x = unit(rng);
+                y = unit(rng);
+            } while(x * x + y * y > 1.0);
+            x *= radius;
+            y *= radius;
+        }
+        else if( dist == ON_CIRCLE ) {
+            double t = unit(rng) * 3.14159265358979323846;
+            x = cos(t) * radius;
+            y = sin(t) * radius;
+        }
+        else if( dist == GAUSSIAN ) {
+            do {
+                x = normal(rng);
+                y = normal(rng);
+            } while(x * x + y * y > radius * radius);
+        }
+        else if( dist == CLUSTERED ) {
+            int c = (int)(rng() % 16);
+            x = max(-radius, min(radius, centres[c][0] + blob(rng)));
+            y = max(-radius, min(radius, centres[c][1] + blob(rng)));
+        }
+        else {
+            // 1001 stops on each of the axes, both diagonals and the bottom edge
+            const double dirs[5][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}, {1, 0}};
+            int line = (int)(rng() % 5);
+            double t = (double)(rng() % 1001) / 500 - 1;
+            x = t * dirs[line][0] * radius;
+            y = line == 4 ? -radius : t * dirs[line][1] * radius;
+        }
+
+        pts[i].x = (int)x;
+        pts[i].y = (int)y;
+
+    }
+
+}
+
+/*timing every engine on every distribution, best of a few runs; threads > 0 runs them on a pool*/
+void runBenchmark(size_t n, unsigned threads) {
+
+    const pointDistribution dists[] = {UNIFORM_SQUARE, UNIFORM_DISK, ON_CIRCLE, GAUSSIAN};
+    hullOptions configs[] = {{GRAHAM_SCAN, false}, {GRAHAM_SCAN, false, NULL, RADIX_SORT},
+        {GRAHAM_SCAN, false, NULL, DELTA_SORT}, {MONOTONE_CHAIN, false}, {CHAN_HULL, false},
+        {QUICK_HULL, false}, {AUTO_SELECT, false}, {GRAHAM_SCAN, true}, {MONOTONE_CHAIN, true},
+        {MONOTONE_CHAIN, false}};
+    const char* configNames[] = {"graham", "graham+radix", "graham+delta", "monotone", "chan", "quick",
+        "auto", "graham+cull", "monotone+cull", "offload"};
+    const int configCount = sizeof(configs) / sizeof(configs[0]);
+    const int runs = 3;
+
+    vector<coord> pts, out;
+    hullScratch scratch;
+
+    unique_ptr<threadPool> pool;
+    if( threads > 0 ) {
+        pool.reset(new threadPool(threads));
+        for(hullOptions& opts : configs) {
+            opts.pool = pool.get();
+        }
+    }
+
+    // the offload config always has a device, on a one-worker pool of its own in serial runs
+    unique_ptr<threadPool> devicePool(threads > 0 ? NULL : new threadPool(1));
+    hostDevice device(pool ? *pool : *devicePool);
+    configs[configCount - 1].device = &device;
+    configs[configCount - 1].offloadMin = 0;
+
+    cout << "distribution      n           engine          ms         hull     culled" << endl;
+    for(pointDistribution dist : dists) {
+
+        generatePoints(dist, n, 12345u, pts);
+
+        for(int e=0; e<configCount; e++) {
+
+            double best = 0;
+            for(int r=0; r<runs; r++) {
+
+                chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+                computeHull(pts.data(), n, out, scratch, configs[e]);
+                double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+                if( r == 0 || ms < best ) {
+                    best = ms;
+                }
+
+            }
+
+            printf("%-17s %-11zu %-15s %-10.2f %-8zu %zu\n", distributionName(dist), n, configNames[e], best,
+                out.size(), scratch.culled);
+
+        }
+
+    }
+
+}
+
+/*sliding window over a stream of uniform points: per step one point enters and the oldest leaves,
+  then the hull is read. dynamicHull against recomputing the window with the monotone chain; an
+  untimed replay of the first steps then compares the two and counts the steps they differ on*/
+void runWindowBenchmark(size_t steps) {
+
+    const size_t windows[] = {100, 1000, 10000, 100000};
+    vector<coord> pts, out;
+    hullScratch scratch;
+
+    cout << "window      dynamic us/step   recompute us/step   faster      mismatches" << endl;
+    for(size_t w : windows) {
+
+        generatePoints(UNIFORM_SQUARE, w + steps, 777u, pts);
+
+        dynamicHull dyn;
+        for(size_t i=0; i<w; i++) {
+            dyn.insert(pts[i]);
+        }
+
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        for(size_t i=0; i<steps; i++) {
+            dyn.insert(pts[w + i]);
+            dyn.erase(pts[i]);
+            dyn.query();
+        }
+        double dynamicUs = chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count() / steps;
+
+        // recomputing is O(w log w) a step, so big windows get fewer steps
+        size_t recomputeSteps = min(steps, max((size_t)10, (size_t)20000000 / w));
+        t0 = chrono::steady_clock::now();
+        for(size_t i=0; i<recomputeSteps; i++) {
+            computeHull(pts.data() + i + 1, w, out, scratch, MONOTONE_CHAIN);
+        }
+        double recomputeUs = chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count() /
+            recomputeSteps;
+
+        dynamicHull replay;
+        for(size_t i=0; i<w; i++) {
+            replay.insert(pts[i]);
+        }
+        size_t wrong = 0, checks = min(recomputeSteps, (size_t)100);
+        for(size_t i=0; i<checks; i++) {
+
+            replay.insert(pts[w + i]);
+            replay.erase(pts[i]);
+            computeHull(pts.data() + i + 1, w, out, scratch, MONOTONE_CHAIN);
+
+            const vector<coord>& live = replay.query();
+            bool same = live.size() == out.size();
+            for(size_t k=0; same && k<out.size(); k++) {
+                same = live[k].x == out[k].x && live[k].y == out[k].y;
+            }
+            wrong += !same;
+
+        }
+
+        printf("%-11zu %-17.2f %-19.2f %-11s %zu of %zu\n", w, dynamicUs, recomputeUs,
+            dynamicUs < recomputeUs ? "dynamic" : "recompute", wrong, checks);
+
+    }
+
+}
+
+/*a daemon's mix of mostly small requests with some big ones, all submitted up front to a
+  hullService and against one computeHull call after another*/
+void runServiceBenchmark(size_t requests, unsigned threads) {
+
+    minstd_rand rng(2024);
+    vector<vector<coord>> sets(requests);
+    for(size_t r=0; r<requests; r++) {
+        size_t n = r % 50 == 49 ? 20000 + rng() % 40000 : 16 + rng() % 2000;
+        generatePoints((pointDistribution)(r % 4), n, (unsigned)r, sets[r]);
+    }
+
+    vector<coord> out;
+    hullScratch scratch;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for(size_t r=0; r<requests; r++) {
+        computeHull(sets[r].data(), sets[r].size(), out, scratch);
+    }
+    double serialMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    threadPool pool(threads);
+    hullService service(pool);
+    vector<future<vector<coord>>> results;
+    results.reserve(requests);
+
+    size_t deepest = 0;
+    t0 = chrono::steady_clock::now();
+    for(size_t r=0; r<requests; r++) {
+        results.push_back(service.submit(sets[r].data(), sets[r].size()));
+        deepest = max(deepest, service.queueDepth());
+    }
+
+    size_t wrong = 0;
+    for(size_t r=0; r<requests; r++) {
+
+        vector<coord> hull = results[r].get();
+        if( r % 97 == 0 ) {
+            computeHull(sets[r].data(), sets[r].size(), out, scratch);
+            for(size_t i=0; i<out.size() && hull.size() == out.size(); i++) {
+                wrong += hull[i].x != out[i].x || hull[i].y != out[i].y;
+            }
+            wrong += hull.size() != out.size();
+        }
+
+    }
+    double serviceMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    hullServiceStats st = service.stats();
+    printf("requests %zu on %u threads: one by one %.2f ms, service %.2f ms\n", requests, pool.size(),
+        serialMs, serviceMs);
+    printf("batches %zu holding %zu requests, deepest queue %zu, mismatches %zu\n", st.batches, st.batched,
+        deepest, wrong);
+    printf("latency us: p50 %llu  p90 %llu  p99 %llu  p99.9 %llu\n", st.p50, st.p90, st.p99, st.p999);
+
+}
+
+/*milliseconds since t0*/
+double elapsedMs(chrono::steady_clock::time_point t0) {
+
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+}
+
+/*engines of the benchmark suite, run stage by stage rather than through computeHull*/
+enum suiteEngine {
+
+    SUITE_GRAHAM,
+    SUITE_GRAHAM_RADIX,
+    SUITE_GRAHAM_DELTA,
+    SUITE_MONOTONE,
+    SUITE_CHAN,
+    SUITE_QUICK
+
+};
+
+/*stage timings of one suite run*/
+struct suiteRun {
+
+    const char* stage[4];
+    double ms[4];
+    int stages;
+    double total;
+    size_t hull;
+
+    void add(const char* name, chrono::steady_clock::time_point t0) {
+
+        stage[stages] = name;
+        ms[stages] = elapsedMs(t0);
+        total += ms[stages];
+        stages++;
+
+    }
+
+};
+
+/*timing one engine's stages over its own copy of pts*/
+suiteRun runSuiteEngine(suiteEngine engine, const vector<coord>& pts, vector<coord>& work,
+    vector<coord>& out) {
+
+    size_t n = pts.size();
+    work = pts;
+    scratchArena& arena = threadArena();
+    arenaScope scope(arena);
+    coord* aux = arena.take<coord>(n);
+
+    suiteRun run = suiteRun();
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+    if( engine == SUITE_MONOTONE ) {
+
+        radixSortLex(work.data(), n, aux);
+        run.add("radixSortLex", t0);
+
+        t0 = chrono::steady_clock::now();
+        monotoneChainSorted(work.data(), n, out);
+        run.add("chains", t0);
+
+    }
+    else if( engine == SUITE_CHAN ) {
+
+        chanHull(work.data(), n, out);
+        run.add("chanHull", t0);
+
+    }
+    else if( engine == SUITE_QUICK ) {
+
+        quickHull(work.data(), n, out, NULL);
+        run.add("quickHull", t0);
+
+    }
+    else {
+
+        findStart(work.data(), n);
+        run.add("findStart", t0);
+
+        if( engine == SUITE_GRAHAM_DELTA ) {
+            t0 = chrono::steady_clock::now();
+            deltaSortAngle(work.data(), n);
+            run.add("deltaSort", t0);
+        }
+        else {
+
+            t0 = chrono::steady_clock::now();
+            fillAngles(work.data(), n);
+            run.add("storeAngle", t0);
+
+            t0 = chrono::steady_clock::now();
+            if( engine == SUITE_GRAHAM_RADIX && n > 2 ) {
+                radixSortAngle(work.data(), 1, n - 1, aux, arena.take<angleKey>(2 * (n - 1)));
+            }
+            else if( n > 2 ) {
+                mergeSort(work.data(), 1, n - 1, aux);
+            }
+            run.add(engine == SUITE_GRAHAM_RADIX ? "radixSortAngle" : "mergeSort", t0);
+
+        }
+
+        t0 = chrono::steady_clock::now();
+        scanSorted(work.data(), n, out);
+        run.add("findingHull", t0);
+
+    }
+
+    run.hull = out.size();
+    return run;
+
+}
+
+/*every distribution at sizes 1e3, 1e4, ... up to maxN through every engine, stage by stage,
+  printed as one JSON array; each entry is the fastest of a few runs*/
+void runSuite(size_t maxN) {
+
+    const pointDistribution dists[] = {UNIFORM_SQUARE, UNIFORM_DISK, ON_CIRCLE, GAUSSIAN, CLUSTERED,
+        COLLINEAR_DUPLICATES};
+    const suiteEngine engines[] = {SUITE_GRAHAM, SUITE_GRAHAM_RADIX, SUITE_GRAHAM_DELTA, SUITE_MONOTONE,
+        SUITE_CHAN, SUITE_QUICK};
+    const char* engineNames[] = {"graham", "graham+radix", "graham+delta", "monotone", "chan", "quick"};
+    const int engineCount = sizeof(engines) / sizeof(engines[0]);
+
+    vector<coord> pts, work, out;
+    bool first = true;
+
+    printf("[\n");
+    for(pointDistribution dist : dists) {
+
+        for(size_t n=1000; n<=maxN; n*=10) {
+
+            generatePoints(dist, n, 2024u, pts);
+            int runs = n <= 1000000 ? 3 : 1;
+
+            for(int e=0; e<engineCount; e++) {
+
+                suiteRun best = suiteRun();
+                for(int r=0; r<runs; r++) {
+                    suiteRun run = runSuiteEngine(engines[e], pts, work, out);
+                    if( r == 0 || run.total < best.total ) {
+                        best = run;
+                    }
+                }
+
+                printf("%s  {\"distribution\": \"%s\", \"n\": %zu, \"engine\": \"%s\", \"hull\": %zu, "
+                    "\"total_ms\": %.4f, \"stages_ms\": {", first ? "" : ",\n", distributionName(dist), n,
+                    engineNames[e], best.hull, best.total);
+                for(int s=0; s<best.stages; s++) {
+                    printf("%s\"%s\": %.4f", s == 0 ? "" : ", ", best.stage[s], best.ms[s]);
+                }
+                printf("}}");
+                fflush(stdout);
+                first = false;
+
+            }
+
+        }
+
+    }
+    printf("\n]\n");
+
+}
+
+int main(int argc, char* argv[])
+{
+    // flags may go anywhere: --sorted also dumps the sorted input,
+    // --out=int32|int64|double writes the hull as packed pairs instead of text,
+    // --chunk=<points> makes read stream the file that many points at a time,
+    // --calipers adds the diameter, width and minimum rectangles after a text hull
+    bool dumpSorted = false;
+    bool showCalipers = false;
+    pointFormat outFormat = TEXT_POINTS;
+    size_t chunkPoints = 0;
+    vector<string> args;
+    for(int i=1; i<argc; i++) {
+
+        string arg = argv[i];
+        if( arg == "--sorted" ) {
+            dumpSorted = true;
+        }
+        else if( arg.compare(0, 6, "--out=") == 0 ) {
+            outFormat = formatByName(arg.substr(6));
+        }
+        else if( arg == "--calipers" ) {
+            showCalipers = true;
+        }
+        else if( arg.compare(0, 8, "--chunk=") == 0 ) {
+            chunkPoints = strtoull(arg.c_str() + 8, NULL, 10);
+        }
+        else {
+            args.push_back(arg);
+        }
+
+    }
+
+    // ./hull bench [count] [threads]
+    if( args.size() > 0 && args[0] == "bench" ) {
+
+        runBenchmark(args.size() > 1 ? strtoull(args[1].c_str(), NULL, 10) : 1000000,
+            args.size() > 2 ? atoi(args[2].c_str()) : 0);
+        return 0;
+
+    }
+
+    // ./hull suite [max count], JSON on stdout
+    if( args.size() > 0 && args[0] == "suite" ) {
+
+        runSuite(args.size() > 1 ? strtoull(args[1].c_str(), NULL, 10) : 10000000);
+        return 0;
+
+    }
+
+    // ./hull service [requests] [threads]
+    if( args.size() > 0 && args[0] == "service" ) {
+
+        runServiceBenchmark(args.size() > 1 ? strtoull(args[1].c_str(), NULL, 10) : 5000,
+            args.size() > 2 ? atoi(args[2].c_str()) : 0);
+        return 0;
+
+    }
+
+    // ./hull window [steps]
+    if( args.size() > 0 && args[0] == "window" ) {
+
+        runWindowBenchmark(args.size() > 1 ? strtoull(args[1].c_str(), NULL, 10) : 20000);
+        return 0;
+
+    }
+
+    resultWriter writer(1);
+    bool text = outFormat == TEXT_POINTS;
+
+    // ./hull read <file | -> [text | int32 | int64 | double]
+    if( args.size() > 1 && args[0] == "read" ) {
+
+        vector<coord> hull;
+        hullScratch scratch;
+        string error;
+        pointFormat format = formatByName(args.size() > 2 ? args[2] : "text");
+        bool ok = chunkPoints > 0 ?
+            streamHull(args[1].c_str(), format, chunkPoints, hull, scratch, hullOptions(), error) :
+            computeHull(args[1].c_str(), format, hull, scratch, hullOptions(), error);
+        if( !ok ) {
+            cerr << error << endl;
+            return 1;
+        }
+
+        if( text ) {
+            writer.text("Coordinates of Convex Hull are:-\n\n");
+        }
+        writePoints(writer, hull.data(), hull.size(), outFormat);
+        if( text && showCalipers ) {
+            writeCalipers(writer, hull.data(), hull.size());
+        }
+        writer.flush();
+#ifdef HULL_METRICS
+        printMetrics(stderr, totalMetrics());
+#endif
+
+        return writer.good() ? 0 : 1;
+
+    }
+
+    vector<coord> coordArr = {{3, 7}, {5, 4}, {9, 21}, {6, 14}, {0, 20}, {2, 0}, {-5, 10},
+    {10, 8}, {0, 2}, {0, 0}, {4, 0}};
+
+    // only the built-in sample is stepped through, a random set would mean n * h lines and pauses
+    bool sample = args.empty();
+
+    // random points: ./hull <count> [range]
+    if( !sample ) {
+
+        size_t n = strtoull(args[0].c_str(), NULL, 10);
+        int range = args.size() > 1 ? atoi(args[1].c_str()) : 10;
+        if( range <= 0 ) {
+            range = 10;
+        }
+
+        coordArr.assign(n, coord());
+        srand(time(NULL));
+        for(size_t i=0; i<n; i++){
+            coordArr[i].x = rand()%range;
+            coordArr[i].y = rand()%range;
+        }
+
+    }
+
+    size_t n = coordArr.size();
+    sortPoints(coordArr.data(), n);
+    
+    if( dumpSorted && text ) {
+        writer.text("Given coordinates are:-\n\n");
+        writePoints(writer, coordArr.data(), n, outFormat);
+        writer.text("\n");
+    }
+    writer.flush();
+
+    vector<coord> hull;
+
+#ifndef HULL_QUIET
+    if( text && sample ) {
+        cout << "Intermediate stacks of coordinates are:-" << endl << endl;
+        interactiveTrace trace;
+        scanSorted(coordArr.data(), n, hull, trace);
+    }
+    else {
+        scanSorted(coordArr.data(), n, hull);
+    }
+#else
+    scanSorted(coordArr.data(), n, hull);
+#endif
+
+    if( text ) {
+        writer.text("Coordinates of Convex Hull are:-\n\n");
+    }
+    writePoints(writer, hull.data(), hull.size(), outFormat);
+    writer.flush();
+#ifdef HULL_METRICS
+    printMetrics(stderr, totalMetrics());
+#endif
+
+    return writer.good() ? 0 : 1;
+
+}
@@ -0,0 +1,498 @@
+/*header-only part of the hull code, for use from other programs: exact orientation predicates and
+  hull kernels templated on the coordinate type and on how coordinates are read from the caller's
+  point struct, so points are never copied into coord. Everything lives in namespace hull*/
+#ifndef CONVEX_HULL_HPP
+#define CONVEX_HULL_HPP
+
+#include<cmath>
+#include<cstddef>
+#include<array>
+#include<vector>
+#include<algorithm>
+#include<type_traits>
+#include<utility>
+
+namespace hull {
+
+/*exact a + b as x + y*/
+inline void twoSum(double a, double b, double& x, double& y) {
+
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+
+}
+
+/*exact a * b as x + y*/
+inline void twoProduct(double a, double b, double& x, double& y) {
+
+    x = a * b;
+    y = std::fma(a, b, -x);
+
+}
+
+/*adding b to the nonoverlapping expansion e[0..n) in place, returns the new length*/
+inline int growExpansion(double* e, int n, double b) {
+
+    double q = b;
+    for(int i=0; i<n; i++) {
+        twoSum(q, e[i], q, e[i]);
+    }
+    e[n] = q;
+
+    return n + 1;
+
+}
+
+/*sign of an expansion, the most significant component is the last nonzero one*/
+inline int expansionSign(const double* e, int n) {
+
+    for(int i=n-1; i>=0; i--) {
+        if( e[i] != 0 ) {
+            return e[i] > 0 ? 1 : -1;
+        }
+    }
+
+    return 0;
+
+}
+
+/*sign of the sum of the products p[2i] * p[2i + 1], exactly*/
+inline int exactProductSum(const double* p, int terms) {
+
+    double e[24];
+    int n = 0;
+    for(int i=0; i<terms; i++) {
+
+        double x, y;
+        twoProduct(p[2 * i], p[2 * i + 1], x, y);
+        n = growExpansion(e, n, y);
+        n = growExpansion(e, n, x);
+
+    }
+
+    return expansionSign(e, n);
+
+}
+
+/*relative error bound of the double filters, (3 + 16 eps) eps from Shewchuk's orient2d*/
+constexpr double filterBound = (3.0 + 16.0 * 1.1102230246251565e-16) * 1.1102230246251565e-16;
+
+/*exact predicates picked at compile time by coordinate type:
+  cross(x1, y1, x2, y2) is the sign of x1 * y2 - y1 * x2,
+  orient(a, b, c) the sign of (b - a) x (c - a), 1 for a left turn*/
+template<typename T> struct predicate;
+
+/*int: 64-bit products, exact while every |coordinate| < 2^30*/
+template<> struct predicate<int> {
+
+    static constexpr int cross(int x1, int y1, int x2, int y2) {
+
+        long long d = (long long)x1 * y2 - (long long)y1 * x2;
+        return (d > 0) - (d < 0);
+
+    }
+
+    static constexpr int orient(int ax, int ay, int bx, int by, int cx, int cy) {
+
+        long long d = ((long long)bx - ax) * ((long long)cy - ay) - ((long long)by - ay) * ((long long)cx - ax);
+        return (d > 0) - (d < 0);
+
+    }
+
+};
+
+/*long long: 128-bit products, exact while every |coordinate| < 2^62*/
+template<> struct predicate<long long> {
+
+    static constexpr int cross(long long x1, long long y1, long long x2, long long y2) {
+
+        __int128 d = (__int128)x1 * y2 - (__int128)y1 * x2;
+        return (d > 0) - (d < 0);
+
+    }
+
+    static constexpr int orient(long long ax, long long ay, long long bx, long long by, long long cx, long long cy) {
+
+        __int128 d = ((__int128)bx - ax) * ((__int128)cy - ay) - ((__int128)by - ay) * ((__int128)cx - ax);
+        return (d > 0) - (d < 0);
+
+    }
+
+};
+
+/*double: floating-point filter, exact expansion arithmetic only when it cannot decide*/
+template<> struct predicate<double> {
+
+    static int cross(double x1, double y1, double x2, double y2) {
+
+        double l = x1 * y2;
+        double r = y1 * x2;
+        double d = l - r;
+        double bound = filterBound * (std::fabs(l) + std::fabs(r));
+
+        if( d > bound ) {
+            return 1;
+        }
+        if( -d > bound ) {
+            return -1;
+        }
+
+        const double p[4] = {x1, y2, -y1, x2};
+        return exactProductSum(p, 2);
+
+    }
+
+    static int orient(double ax, double ay, double bx, double by, double cx, double cy) {
+
+        double l = (bx - ax) * (cy - ay);
+        double r = (by - ay) * (cx - ax);
+        double d = l - r;
+        double bound = filterBound * (std::fabs(l) + std::fabs(r));
+
+        if( d > bound ) {
+            return 1;
+        }
+        if( -d > bound ) {
+            return -1;
+        }
+
+        // expanded so that no rounded difference is involved
+        const double p[12] = {bx, cy, -bx, ay, -ax, cy, -by, cx, by, ax, ay, cx};
+        return exactProductSum(p, 6);
+
+    }
+
+};
+
+/*float: every float is a double, so it goes through the double filter*/
+template<> struct predicate<float> {
+
+    static int cross(float x1, float y1, float x2, float y2) {
+
+        return predicate<double>::cross(x1, y1, x2, y2);
+
+    }
+
+    static int orient(float ax, float ay, float bx, float by, float cx, float cy) {
+
+        return predicate<double>::orient(ax, ay, bx, by, cx, cy);
+
+    }
+
+};
+
+/*reads coordinates out of any struct with x and y members; pass another accessor with x(p) and
+  y(p) for other layouts*/
+struct memberAccessor {
+
+    template<typename P>
+    constexpr auto x(const P& p) const -> decltype(p.x) {
+
+        return p.x;
+
+    }
+
+    template<typename P>
+    constexpr auto y(const P& p) const -> decltype(p.y) {
+
+        return p.y;
+
+    }
+
+};
+
+/*the coordinate type Accessor reads from a P, which picks the predicate*/
+template<typename P, typename Accessor>
+using coordinateOf = typename std::decay<decltype(std::declval<const Accessor&>().x(std::declval<const P&>()))>::type;
+
+/*(x, y) order*/
+template<typename P, typename Accessor>
+constexpr bool lexLess(const P& a, const P& b, const Accessor& get) {
+
+    return get.x(a) < get.x(b) || (get.x(a) == get.x(b) && get.y(a) < get.y(b));
+
+}
+
+/*1 when a -> b -> c turns left*/
+template<typename P, typename Accessor>
+constexpr bool leftTurn(const P& a, const P& b, const P& c, const Accessor& get) {
+
+    return predicate<coordinateOf<P, Accessor>>::orient(get.x(a), get.y(a), get.x(b), get.y(b),
+        get.x(c), get.y(c)) > 0;
+
+}
+
+/*reversing idx[start..end)*/
+constexpr void reverseIndices(std::size_t* idx, std::size_t start, std::size_t end) {
+
+    while(start + 1 < end) {
+
+        std::size_t temp = idx[start];
+        idx[start] = idx[end - 1];
+        idx[end - 1] = temp;
+        start++;
+        end--;
+
+    }
+
+}
+
+/*Andrew's chains over the points pts[idx[0..n)], which are sorted by (x, y). out receives the
+  hull as indices into pts (room for n + 1), counter-clockwise from the lowest, then leftmost
+  point, with collinear points left out; returns the hull size*/
+template<typename P, typename Accessor>
+constexpr std::size_t chainSorted(const P* pts, const std::size_t* idx, std::size_t n, std::size_t* out,
+    const Accessor& get) {
+
+    if( n == 0 ) {
+        return 0;
+    }
+
+    const P& first = pts[idx[0]];
+    const P& last = pts[idx[n - 1]];
+    if( get.x(first) == get.x(last) && get.y(first) == get.y(last) ) {
+        out[0] = idx[0];
+        return 1;
+    }
+
+    // lower hull, left to right
+    std::size_t k = 0;
+    for(std::size_t i=0; i<n; i++) {
+
+        while(k >= 2 && !leftTurn(pts[out[k - 2]], pts[out[k - 1]], pts[idx[i]], get)) {
+            k--;
+        }
+        out[k++] = idx[i];
+
+    }
+
+    // upper hull, right to left, its last point is the first of the lower one again
+    std::size_t lower = k + 1;
+    for(std::size_t i=n-1; i>0; i--) {
+
+        while(k >= lower && !leftTurn(pts[out[k - 2]], pts[out[k - 1]], pts[idx[i - 1]], get)) {
+            k--;
+        }
+        out[k++] = idx[i - 1];
+
+    }
+    k--;
+
+    std::size_t start = 0;
+    for(std::size_t i=1; i<k; i++) {
+
+        const P& p = pts[out[i]];
+        const P& s = pts[out[start]];
+        if( get.y(p) < get.y(s) || (get.y(p) == get.y(s) && get.x(p) < get.x(s)) ) {
+            start = i;
+        }
+
+    }
+
+    if( start != 0 ) {
+        reverseIndices(out, 0, start);
+        reverseIndices(out, start, k);
+        reverseIndices(out, 0, k);
+    }
+
+    return k;
+
+}
+
+/*largest n the fixed-size kernels are instantiated for*/
+constexpr std::size_t smallKernelMax = 8;
+
+/*hull of exactly N points with every loop bound known at compile time, so the insertion sort
+  and the chains unroll; usable in constant expressions for integer coordinates*/
+template<std::size_t N>
+struct smallHull {
+
+    template<typename P, typename Accessor>
+    static constexpr std::size_t run(const P* pts, std::size_t* out, const Accessor& get) {
+
+        std::size_t idx[N] = {};
+        for(std::size_t i=0; i<N; i++) {
+            idx[i] = i;
+        }
+
+        for(std::size_t i=1; i<N; i++) {
+            for(std::size_t j=i; j>0 && lexLess(pts[idx[j]], pts[idx[j - 1]], get); j--) {
+                std::size_t temp = idx[j];
+                idx[j] = idx[j - 1];
+                idx[j - 1] = temp;
+            }
+        }
+
+        return chainSorted(pts, idx, N, out, get);
+
+    }
+
+};
+
+template<>
+struct smallHull<0> {
+
+    template<typename P, typename Accessor>
+    static constexpr std::size_t run(const P*, std::size_t*, const Accessor&) {
+
+        return 0;
+
+    }
+
+};
+
+template<>
+struct smallHull<1> {
+
+    template<typename P, typename Accessor>
+    static constexpr std::size_t run(const P*, std::size_t* out, const Accessor&) {
+
+        out[0] = 0;
+        return 1;
+
+    }
+
+};
+
+template<>
+struct smallHull<2> {
+
+    template<typename P, typename Accessor>
+    static constexpr std::size_t run(const P* pts, std::size_t* out, const Accessor& get) {
+
+        if( get.x(pts[0]) == get.x(pts[1]) && get.y(pts[0]) == get.y(pts[1]) ) {
+            out[0] = 0;
+            return 1;
+        }
+
+        bool second = get.y(pts[1]) < get.y(pts[0]) || (get.y(pts[1]) == get.y(pts[0]) && get.x(pts[1]) < get.x(pts[0]));
+        out[0] = second ? 1 : 0;
+        out[1] = second ? 0 : 1;
+        return 2;
+
+    }
+
+};
+
+/*a proper triangle only needs its turn and its lowest corner*/
+template<>
+struct smallHull<3> {
+
+    template<typename P, typename Accessor>
+    static constexpr std::size_t run(const P* pts, std::size_t* out, const Accessor& get) {
+
+        int o = predicate<coordinateOf<P, Accessor>>::orient(get.x(pts[0]), get.y(pts[0]), get.x(pts[1]),
+            get.y(pts[1]), get.x(pts[2]), get.y(pts[2]));
+        if( o == 0 ) {
+            std::size_t idx[3] = {0, 1, 2};
+            for(std::size_t i=1; i<3; i++) {
+                for(std::size_t j=i; j>0 && lexLess(pts[idx[j]], pts[idx[j - 1]], get); j--) {
+                    std::size_t temp = idx[j];
+                    idx[j] = idx[j - 1];
+                    idx[j - 1] = temp;
+                }
+            }
+            return chainSorted(pts, idx, 3, out, get);
+        }
+
+        std::size_t start = 0;
+        for(std::size_t i=1; i<3; i++) {
+            if( get.y(pts[i]) < get.y(pts[start]) || (get.y(pts[i]) == get.y(pts[start]) && get.x(pts[i]) < get.x(pts[start])) ) {
+                start = i;
+            }
+        }
+
+        // counter-clockwise is 0 1 2 for a left turn, 0 2 1 otherwise
+        std::size_t step = o > 0 ? 1 : 2;
+        for(std::size_t i=0; i<3; i++) {
+            out[i] = (start + step * i) % 3;
+        }
+        return 3;
+
+    }
+
+};
+
+/*the fixed-size kernel for a runtime n <= smallKernelMax, out has room for n + 1*/
+template<typename P, typename Accessor = memberAccessor>
+std::size_t smallHullOf(const P* pts, std::size_t n, std::size_t* out, const Accessor& get = Accessor()) {
+
+    switch(n) {
+        case 0: return smallHull<0>::run(pts, out, get);
+        case 1: return smallHull<1>::run(pts, out, get);
+        case 2: return smallHull<2>::run(pts, out, get);
+        case 3: return smallHull<3>::run(pts, out, get);
+        case 4: return smallHull<4>::run(pts, out, get);
+        case 5: return smallHull<5>::run(pts, out, get);
+        case 6: return smallHull<6>::run(pts, out, get);
+        case 7: return smallHull<7>::run(pts, out, get);
+        default: return smallHull<8>::run(pts, out, get);
+    }
+
+}
+
+static_assert(smallKernelMax == 8, "smallHullOf has a case per fixed size");
+
+/*indices of the hull of a fixed-size array*/
+template<std::size_t N>
+struct smallResult {
+
+    std::array<std::size_t, N + 1> idx = {};
+    std::size_t size = 0;
+
+};
+
+/*hull of std::array points, resolved at compile time by size and constexpr for integer
+  coordinates: constexpr auto h = hull::convexHull(std::array<pt, 4>{...})*/
+template<typename P, std::size_t N, typename Accessor = memberAccessor>
+constexpr smallResult<N> convexHull(const std::array<P, N>& pts, const Accessor& get = Accessor()) {
+
+    smallResult<N> r;
+    r.size = smallHull<N>::run(pts.data(), r.idx.data(), get);
+    return r;
+
+}
+
+/*hull of pts[0..n) as indices into pts, counter-clockwise from the lowest, then leftmost point;
+  collinear points are left out and of equal points one index is kept*/
+template<typename P, typename Accessor = memberAccessor>
+void convexHull(const P* pts, std::size_t n, std::vector<std::size_t>& out, const Accessor& get = Accessor()) {
+
+    out.resize(n + 1);
+    if( n <= smallKernelMax ) {
+        out.resize(smallHullOf(pts, n, out.data(), get));
+        return;
+    }
+
+    std::vector<std::size_t> idx(n);
+    for(std::size_t i=0; i<n; i++) {
+        idx[i] = i;
+    }
+    std::sort(idx.begin(), idx.end(), [pts, &get](std::size_t a, std::size_t b) {
+        return lexLess(pts[a], pts[b], get);
+    });
+
+    out.resize(chainSorted(pts, idx.data(), n, out.data(), get));
+
+}
+
+/*the same hull as copies of the caller's points*/
+template<typename P, typename Accessor = memberAccessor>
+void convexHull(const P* pts, std::size_t n, std::vector<P>& out, const Accessor& get = Accessor()) {
+
+    std::vector<std::size_t> idx;
+    convexHull(pts, n, idx, get);
+
+    out.clear();
+    out.reserve(idx.size());
+    for(std::size_t i : idx) {
+        out.push_back(pts[i]);
+    }
+
+}
+
+}
+
+#endif
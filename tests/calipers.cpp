@@ -0,0 +1,196 @@
+// rotating calipers against O(h^2) brute force on random, near-circular and parallel-edge
+// hulls, and the batch calipers against one call per hull
+
+#define main hullMain
+#include "../convex hull.cpp"
+#undef main
+
+/*brute-force measures of a hull with h >= 2: every pair for the diameter, every edge against
+  every vertex for the width and the two rectangles*/
+struct bruteCalipers {
+
+    unsigned long long diameter2 = 0;
+    long double width = 1e300L, area = 1e300L, perimeter = 1e300L;
+
+};
+
+bruteCalipers bruteForce(const vector<coord>& h) {
+
+    bruteCalipers b;
+    size_t m = h.size();
+    for(size_t i=0; i<m; i++) {
+        for(size_t j=0; j<m; j++) {
+            b.diameter2 = max(b.diameter2, distance2(h[i], h[j]));
+        }
+    }
+
+    for(size_t i=0; i<m; i++) {
+
+        coord a = h[i], e = h[(i + 1) % m];
+        __int128 hi = 0, lo = 0, height = 0;
+        for(size_t k=0; k<m; k++) {
+            __int128 along = caliperDot(a, e, a, h[k]);
+            hi = max(hi, along);
+            lo = min(lo, along);
+            height = max(height, caliperCross(a, e, a, h[k]));
+        }
+
+        long double len2 = distance2(a, e), len = sqrtl(len2);
+        b.width = min(b.width, (long double)height / len);
+        b.area = min(b.area, (long double)(hi - lo) * (long double)height / len2);
+        b.perimeter = min(b.perimeter, 2 * ((long double)(hi - lo) + (long double)height) / len);
+
+    }
+
+    return b;
+
+}
+
+bool agrees(long double got, long double want) {
+
+    return fabsl(got - want) <= 1e-9L * max((long double)1, fabsl(want));
+
+}
+
+/*no hull vertex lies outside the rectangle by more than rounding*/
+bool encloses(const hullRect& r, const vector<coord>& h, double range) {
+
+    for(int k=0; k<4; k++) {
+
+        double ax = r.corner[k][0], ay = r.corner[k][1];
+        double bx = r.corner[(k + 1) % 4][0], by = r.corner[(k + 1) % 4][1];
+        double len = hypot(bx - ax, by - ay);
+        if( len == 0 ) {
+            continue;
+        }
+
+        for(size_t i=0; i<h.size(); i++) {
+            double side = ((bx - ax) * (h[i].y - ay) - (by - ay) * (h[i].x - ax)) / len;
+            if( side < -1e-6 * max(1.0, range) ) {
+                return false;
+            }
+        }
+
+    }
+
+    return true;
+
+}
+
+/*one random hull: full-range or small-grid points, on a circle in every seventh round, with
+  x snapped to multiples of three in every eleventh so many edges are parallel*/
+void randomHull(mt19937& rng, int round, vector<coord>& h, double& range) {
+
+    bool full = round % 4 == 0, circle = round % 7 == 0;
+    range = full ? (double)maxCoordinate : (double)(rng() % 30 + 2);
+    size_t n = rng() % (round % 10 == 0 ? 3000 : 40) + 1;
+
+    uniform_int_distribution<long long> pick(full ? -maxCoordinate : 0, (long long)range);
+    uniform_real_distribution<double> turn(0, 6.283185307179586);
+    vector<coord> pts(n);
+    for(size_t i=0; i<n; i++) {
+
+        pts[i] = coord();
+        if( circle ) {
+            double t = turn(rng), r = full ? 1e9 : 1000;
+            pts[i].x = (int)(r * cos(t));
+            pts[i].y = (int)(r * sin(t));
+        }
+        else {
+            pts[i].x = (int)pick(rng);
+            pts[i].y = (int)pick(rng);
+        }
+        if( round % 11 == 0 ) {
+            pts[i].x -= pts[i].x % 3;
+        }
+
+    }
+
+    computeHull(pts.data(), n, h, MONOTONE_CHAIN);
+
+}
+
+bool singleHulls() {
+
+    mt19937 rng(5);
+    for(int round=0; round<20000; round++) {
+
+        vector<coord> h;
+        double range;
+        randomHull(rng, round, h, range);
+        hullCalipers c = calipers(h.data(), h.size());
+        if( h.size() < 2 ) {
+            continue;
+        }
+
+        bruteCalipers b = bruteForce(h);
+        if( c.diameter2 != b.diameter2 || distance2(h[c.diameterA], h[c.diameterB]) != b.diameter2 ) {
+            printf("diameter differs in round %d, h = %zu\n", round, h.size());
+            return false;
+        }
+        if( !agrees(c.width, b.width) || !agrees(c.minArea.area, b.area) ||
+            !agrees(c.minPerimeter.perimeter, b.perimeter) ) {
+            printf("width or rectangle differs in round %d, h = %zu\n", round, h.size());
+            return false;
+        }
+        if( !encloses(c.minArea, h, range) || !encloses(c.minPerimeter, h, range) ) {
+            printf("rectangle misses a vertex in round %d, h = %zu\n", round, h.size());
+            return false;
+        }
+
+    }
+
+    return true;
+
+}
+
+/*calipers over the CSR output of computeHulls, serial and on a pool, against one call each*/
+bool batchHulls() {
+
+    mt19937 rng(3);
+    const size_t sets = 5000;
+    vector<coord> pts;
+    vector<size_t> offsets(1, 0);
+    for(size_t s=0; s<sets; s++) {
+        size_t k = rng() % 50 + 1;
+        for(size_t i=0; i<k; i++) {
+            coord c = coord();
+            c.x = rng() % 1000;
+            c.y = rng() % 1000;
+            pts.push_back(c);
+        }
+        offsets.push_back(pts.size());
+    }
+
+    vector<coord> hulls;
+    vector<size_t> hullOffsets;
+    hullScratch scratch;
+    computeHulls(pts.data(), offsets.data(), sets, hulls, hullOffsets, scratch, hullOptions());
+
+    vector<hullCalipers> serial, pooled;
+    threadPool pool(4);
+    calipers(hulls.data(), hullOffsets.data(), sets, serial);
+    calipers(hulls.data(), hullOffsets.data(), sets, pooled, &pool);
+
+    for(size_t s=0; s<sets; s++) {
+        hullCalipers one = calipers(hulls.data() + hullOffsets[s], hullOffsets[s + 1] - hullOffsets[s]);
+        if( memcmp(&one, &serial[s], sizeof one) != 0 || memcmp(&one, &pooled[s], sizeof one) != 0 ) {
+            printf("batch calipers differ for set %zu\n", s);
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+int main() {
+
+    if( !singleHulls() || !batchHulls() ) {
+        return 1;
+    }
+
+    printf("ok\n");
+    return 0;
+
+}
@@ -0,0 +1,167 @@
+// dynamicHull and incrementalHull against computeHull on the live points: random inserts,
+// erases of live points and of missing ones, on small grids full of duplicates and collinear
+// runs and over the full coordinate range
+
+#define main hullMain
+#include "../convex hull.cpp"
+#undef main
+
+bool sameHull(const vector<coord>& a, const vector<coord>& b) {
+
+    if( a.size() != b.size() ) {
+        return false;
+    }
+    for(size_t i=0; i<a.size(); i++) {
+        if( a[i].x != b[i].x || a[i].y != b[i].y ) {
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+vector<coord> referenceHull(const vector<coord>& live) {
+
+    vector<coord> ref;
+    if( !live.empty() ) {
+        computeHull(live.data(), live.size(), ref, MONOTONE_CHAIN);
+    }
+    return ref;
+
+}
+
+coord randomPoint(mt19937& rng, long long range) {
+
+    uniform_int_distribution<long long> pick(-range, range);
+    coord c = coord();
+    c.x = (int)pick(rng);
+    c.y = (int)pick(rng);
+    return c;
+
+}
+
+/*one random sequence on dynamicHull, the multiset it should hold kept alongside*/
+bool dynamicSequence(mt19937& rng, int round) {
+
+    long long range = round % 5 == 0 ? maxCoordinate : (long long)(rng() % 12 + 1);
+    size_t target = rng() % 300 + 1;
+    size_t ops = 600;
+
+    dynamicHull dyn;
+    vector<coord> live;
+    for(size_t op=0; op<ops; op++) {
+
+        unsigned kind = rng() % 10;
+        if( live.empty() || (kind < 5 && live.size() < target) ) {
+
+            // a fresh point, or another copy of a live one
+            coord c = !live.empty() && kind == 0 ? live[rng() % live.size()] : randomPoint(rng, range);
+            dyn.insert(c);
+            live.push_back(c);
+
+        }
+        else if( kind < 9 ) {
+
+            size_t k = rng() % live.size();
+            if( !dyn.erase(live[k]) ) {
+                printf("dynamicHull lost a live point in round %d, op %zu\n", round, op);
+                return false;
+            }
+            live[k] = live.back();
+            live.pop_back();
+
+        }
+        else {
+
+            coord c = randomPoint(rng, range);
+            bool held = false;
+            for(size_t i=0; i<live.size() && !held; i++) {
+                held = live[i].x == c.x && live[i].y == c.y;
+            }
+            if( dyn.erase(c) != held ) {
+                printf("dynamicHull erase of a %s point wrong in round %d, op %zu\n",
+                    held ? "live" : "missing", round, op);
+                return false;
+            }
+            if( held ) {
+                for(size_t i=0; i<live.size(); i++) {
+                    if( live[i].x == c.x && live[i].y == c.y ) {
+                        live[i] = live.back();
+                        live.pop_back();
+                        break;
+                    }
+                }
+            }
+
+        }
+
+        if( dyn.size() != live.size() || !sameHull(dyn.query(), referenceHull(live)) ) {
+            printf("dynamicHull differs from computeHull in round %d, op %zu, %zu points\n", round, op,
+                live.size());
+            return false;
+        }
+
+        // emptied now and then, the pools must come back clean
+        if( op == ops / 2 && round % 3 == 0 ) {
+            dyn.clear();
+            live.clear();
+            if( dyn.size() != 0 || !dyn.query().empty() ) {
+                printf("dynamicHull not empty after clear in round %d\n", round);
+                return false;
+            }
+        }
+
+    }
+
+    return true;
+
+}
+
+/*inserts only on incrementalHull: the hull after each one, and whether it reported a change*/
+bool incrementalSequence(mt19937& rng, int round) {
+
+    long long range = round % 5 == 0 ? maxCoordinate : (long long)(rng() % 12 + 1);
+    size_t n = rng() % 500 + 1;
+
+    incrementalHull inc;
+    vector<coord> live, before;
+    for(size_t i=0; i<n; i++) {
+
+        coord c = !live.empty() && i % 7 == 0 ? live[rng() % live.size()] : randomPoint(rng, range);
+        bool became = inc.insert(c);
+        live.push_back(c);
+
+        vector<coord> ref = referenceHull(live);
+        if( !sameHull(inc.query(), ref) ) {
+            printf("incrementalHull differs from computeHull in round %d after %zu inserts\n", round, i + 1);
+            return false;
+        }
+
+        // a point that became a vertex changes the hull, one that did not leaves it as it was
+        if( became == sameHull(before, ref) ) {
+            printf("incrementalHull insert reported %d wrongly in round %d, insert %zu\n", (int)became,
+                round, i + 1);
+            return false;
+        }
+        before.swap(ref);
+
+    }
+
+    return true;
+
+}
+
+int main() {
+
+    mt19937 rng(15);
+    for(int round=0; round<600; round++) {
+        if( !dynamicSequence(rng, round) || !incrementalSequence(rng, round) ) {
+            return 1;
+        }
+    }
+
+    printf("ok\n");
+    return 0;
+
+}
@@ -0,0 +1,412 @@
+// every engine and option against a brute-force gift wrap: all must give the same vertices in
+// the same order on duplicate-heavy, collinear, full-range and random inputs, Melkman on simple
+// polygons; the radix angle sort must leave the points byte for byte as the merge sort does
+
+#define main hullMain
+#include "../convex hull.cpp"
+#undef main
+
+/*(b - a) x (c - a), exact for any int coordinates*/
+__int128 orient(const coord& a, const coord& b, const coord& c) {
+
+    return (__int128)((long long)b.x - a.x) * ((long long)c.y - a.y) -
+        (__int128)((long long)b.y - a.y) * ((long long)c.x - a.x);
+
+}
+
+unsigned long long span2(const coord& a, const coord& b) {
+
+    unsigned long long dx = (unsigned long long)llabs((long long)b.x - a.x);
+    unsigned long long dy = (unsigned long long)llabs((long long)b.y - a.y);
+    return dx * dx + dy * dy;
+
+}
+
+/*gift wrap: from the lowest, then leftmost point, the next vertex is the one no point lies
+  right of, the farthest one among collinear candidates, until the wrap is back at the start*/
+vector<coord> bruteHull(const vector<coord>& pts) {
+
+    vector<coord> h;
+    if( pts.empty() ) {
+        return h;
+    }
+
+    size_t start = 0;
+    for(size_t i=1; i<pts.size(); i++) {
+        if( pts[i].y < pts[start].y || (pts[i].y == pts[start].y && pts[i].x < pts[start].x) ) {
+            start = i;
+        }
+    }
+
+    coord p = pts[start];
+    while(1) {
+
+        h.push_back(p);
+        coord q = p;
+        for(size_t i=0; i<pts.size(); i++) {
+            if( pts[i].x == p.x && pts[i].y == p.y ) {
+                continue;
+            }
+            if( q.x == p.x && q.y == p.y ) {
+                q = pts[i];
+                continue;
+            }
+            __int128 o = orient(p, q, pts[i]);
+            if( o < 0 || (o == 0 && span2(p, pts[i]) > span2(p, q)) ) {
+                q = pts[i];
+            }
+        }
+
+        if( (q.x == p.x && q.y == p.y) || (q.x == h[0].x && q.y == h[0].y) ) {
+            break;
+        }
+        p = q;
+
+    }
+
+    return h;
+
+}
+
+bool sameHull(const vector<coord>& a, const vector<coord>& b) {
+
+    if( a.size() != b.size() ) {
+        return false;
+    }
+    for(size_t i=0; i<a.size(); i++) {
+        if( a[i].x != b[i].x || a[i].y != b[i].y ) {
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+coord at(long long x, long long y) {
+
+    coord c = coord();
+    c.x = (int)x;
+    c.y = (int)y;
+    return c;
+
+}
+
+/*the test inputs, by kind: a tiny grid full of duplicates, points on one line with a few off it,
+  the corners and edges of the full +-(2^30 - 1) square with random points inside, a circle
+  where every point is a vertex, and the benchmark distributions; every 25th input is big
+  enough for the pool, and for AUTO_SELECT to sample*/
+void randomInput(mt19937& rng, int round, vector<coord>& pts) {
+
+    const long long m = maxCoordinate;
+    bool big = round % 25 == 24;
+    size_t n = big ? 70000 + rng() % 200000 : rng() % (round % 10 == 0 ? 3000 : 60) + 1;
+    pts.clear();
+
+    switch(round % 6) {
+
+        case 0: {
+            long long r = rng() % 8 + 1;
+            for(size_t i=0; i<n; i++) {
+                pts.push_back(at(rng() % r, rng() % r));
+            }
+            break;
+        }
+        case 1: {
+            long long dx = (long long)(rng() % 7) - 3, dy = rng() % 4, x0 = (long long)(rng() % 100) - 50;
+            for(size_t i=0; i<n; i++) {
+                long long k = (long long)(rng() % 200) - 100;
+                pts.push_back(i % 17 == 16 ? at(x0 + rng() % 5, rng() % 5) : at(x0 + k * dx, k * dy));
+            }
+            break;
+        }
+        case 2: {
+            uniform_int_distribution<long long> pick(-m, m);
+            const long long corners[4][2] = {{-m, -m}, {m, -m}, {m, m}, {-m, m}};
+            for(size_t i=0; i<n; i++) {
+                long long x = pick(rng), y = pick(rng);
+                if( i % 5 == 0 ) {
+                    x = corners[rng() % 4][0];
+                    y = corners[rng() % 4][1];
+                }
+                else if( i % 5 == 1 ) {
+                    (rng() % 2 ? x : y) = rng() % 2 ? m : -m;
+                }
+                pts.push_back(at(x, y));
+            }
+            break;
+        }
+        case 3: {
+            double r = round % 4 == 3 ? 1e9 : 1000;
+            size_t k = big ? 2000 : n;
+            for(size_t i=0; i<k; i++) {
+                double t = 6.283185307179586 * (rng() % 1000003) / 1000003.0;
+                pts.push_back(at((long long)(r * cos(t)), (long long)(r * sin(t))));
+            }
+            break;
+        }
+        default: {
+            // the brute force is O(n h), so a big input stays off the circle
+            pointDistribution dist = (pointDistribution)(rng() % 6);
+            generatePoints(big && dist == ON_CIRCLE ? UNIFORM_DISK : dist, n, round, pts);
+            break;
+        }
+
+    }
+
+    shuffle(pts.begin(), pts.end(), rng);
+
+}
+
+/*points through the header's template on a caller's struct, read by an accessor*/
+struct plainPoint {
+
+    long long x, y;
+
+};
+
+/*every route to a hull of pts that must agree with the brute force; false with the name of the
+  first that does not*/
+bool allEngines(const vector<coord>& pts, const vector<coord>& ref, threadPool& pool,
+    hostDevice& device, const char*& failed) {
+
+    struct route {
+        const char* name;
+        hullEngine engine;
+        angleSort sort;
+        bool cull, pooled, offload;
+    };
+    const route routes[] = {
+        {"graham merge", GRAHAM_SCAN, MERGE_SORT, false, false, false},
+        {"graham radix", GRAHAM_SCAN, RADIX_SORT, false, false, false},
+        {"graham delta", GRAHAM_SCAN, DELTA_SORT, false, false, false},
+        {"graham cull", GRAHAM_SCAN, MERGE_SORT, true, false, false},
+        {"graham pool", GRAHAM_SCAN, MERGE_SORT, false, true, false},
+        {"graham radix pool cull", GRAHAM_SCAN, RADIX_SORT, true, true, false},
+        {"monotone", MONOTONE_CHAIN, MERGE_SORT, false, false, false},
+        {"monotone cull pool", MONOTONE_CHAIN, MERGE_SORT, true, true, false},
+        {"chan", CHAN_HULL, MERGE_SORT, false, false, false},
+        {"chan pool", CHAN_HULL, MERGE_SORT, false, true, false},
+        {"quickhull", QUICK_HULL, MERGE_SORT, false, false, false},
+        {"quickhull pool", QUICK_HULL, MERGE_SORT, false, true, false},
+        {"auto", AUTO_SELECT, MERGE_SORT, false, false, false},
+        {"auto pool cull", AUTO_SELECT, MERGE_SORT, true, true, false},
+        {"graham device", GRAHAM_SCAN, MERGE_SORT, false, false, true},
+        {"monotone device pool", MONOTONE_CHAIN, MERGE_SORT, false, true, true},
+    };
+
+    vector<coord> got;
+    hullScratch scratch;
+    for(const route& r : routes) {
+
+        hullOptions opts;
+        opts.engine = r.engine;
+        opts.sort = r.sort;
+        opts.cull = r.cull;
+        opts.pool = r.pooled ? &pool : NULL;
+        if( r.offload ) {
+            opts.device = &device;
+            opts.offloadMin = 0;
+        }
+
+        computeHull(pts.data(), pts.size(), got, scratch, opts);
+        if( !sameHull(got, ref) ) {
+            failed = r.name;
+            return false;
+        }
+
+    }
+
+    pointSet set;
+    for(size_t i=0; i<pts.size(); i++) {
+        set.x.push_back(pts[i].x);
+        set.y.push_back(pts[i].y);
+    }
+    computeHull(set, got, scratch, hullOptions());
+    if( !sameHull(got, ref) ) {
+        failed = "pointSet graham";
+        return false;
+    }
+
+    vector<plainPoint> plain(pts.size());
+    for(size_t i=0; i<pts.size(); i++) {
+        plain[i].x = pts[i].x;
+        plain[i].y = pts[i].y;
+    }
+    vector<size_t> idx;
+    hull::convexHull(plain.data(), plain.size(), idx);
+    got.clear();
+    for(size_t i : idx) {
+        got.push_back(pts[i]);
+    }
+    if( !sameHull(got, ref) ) {
+        failed = "hull::convexHull";
+        return false;
+    }
+
+    return true;
+
+}
+
+/*the radix angle sort and the parallel merge sort leave the points exactly as mergeSort does*/
+bool sortsIdentical(const vector<coord>& pts, threadPool& pool) {
+
+    size_t n = pts.size();
+    if( n < 3 ) {
+        return true;
+    }
+
+    vector<coord> merged(pts), aux(n);
+    storeAngle(merged.data(), n);
+    vector<coord> radix(merged), parallel(merged);
+
+    hullOptions opts;
+    angleSortWork(merged.data(), n, aux.data(), opts);
+    opts.sort = RADIX_SORT;
+    angleSortWork(radix.data(), n, aux.data(), opts);
+    opts.sort = MERGE_SORT;
+    opts.pool = &pool;
+    angleSortWork(parallel.data(), n, aux.data(), opts);
+
+    return memcmp(merged.data(), radix.data(), n * sizeof(coord)) == 0 &&
+        memcmp(merged.data(), parallel.data(), n * sizeof(coord)) == 0;
+
+}
+
+/*vertices of a simple polygon or polyline in order: star-shaped with distinct angles, a square
+  outline with points along its sides, an x-monotone polygon, a straight polyline, or a convex
+  polygon with repeated vertices; started anywhere and listed either way round*/
+void simplePolygon(mt19937& rng, int round, vector<coord>& p) {
+
+    size_t n = rng() % (round % 20 == 0 ? 5000 : 40) + 3;
+    long long r = round % 3 == 0 ? maxCoordinate : (round % 3 == 1 ? 1000000 : 20);
+    p.clear();
+
+    switch(round % 5) {
+
+        case 0:
+            for(size_t i=0; i<n; i++) {
+                double t = 6.283185307179586 * (i + 0.5 * (rng() % 1000) / 1000.0) / n;
+                double len = max((double)r, 1e5) * (0.1 + 0.9 * (rng() % 1000) / 1000.0);
+                p.push_back(at((long long)(len * cos(t)), (long long)(len * sin(t))));
+            }
+            break;
+        case 1: {
+            long long side = rng() % 10 + 1, scale = r / side;
+            for(long long i=0; i<side; i++) p.push_back(at(i * scale, 0));
+            for(long long i=0; i<side; i++) p.push_back(at(side * scale, i * scale));
+            for(long long i=side; i>0; i--) p.push_back(at(i * scale, side * scale));
+            for(long long i=side; i>0; i--) p.push_back(at(0, i * scale));
+            break;
+        }
+        case 2: {
+            vector<long long> xs;
+            for(size_t i=0; i<n; i++) {
+                xs.push_back((long long)(rng() % (2 * r)) - r);
+            }
+            sort(xs.begin(), xs.end());
+            xs.erase(unique(xs.begin(), xs.end()), xs.end());
+            if( xs.size() < 3 ) {
+                xs.assign({-2, 0, 2});
+            }
+            // the inner x values go above or below the axis, the two chains meet at the ends
+            vector<coord> up, low;
+            for(size_t i=1; i+1<xs.size(); i++) {
+                long long y = (long long)(rng() % r) + 1;
+                if( rng() % 2 ) {
+                    up.push_back(at(xs[i], y));
+                }
+                else {
+                    low.push_back(at(xs[i], -y));
+                }
+            }
+            p.push_back(at(xs[0], 0));
+            p.insert(p.end(), low.begin(), low.end());
+            p.push_back(at(xs.back(), 0));
+            p.insert(p.end(), up.rbegin(), up.rend());
+            break;
+        }
+        case 3: {
+            long long step = max(1ll, r / (long long)n / 3);
+            for(size_t i=0; i<n; i++) {
+                p.push_back(at((long long)i * 2 * step, (long long)i * 3 * step));
+            }
+            break;
+        }
+        default:
+            for(size_t i=0; i<n; i++) {
+                double t = 6.283185307179586 * i / n;
+                p.push_back(at((long long)(r * cos(t)), (long long)(r * sin(t))));
+                if( rng() % 4 == 0 ) {
+                    p.push_back(p.back());
+                }
+            }
+            break;
+
+    }
+
+    rotate(p.begin(), p.begin() + rng() % p.size(), p.end());
+    if( rng() % 2 ) {
+        reverse(p.begin(), p.end());
+    }
+
+}
+
+bool melkmanPolygons(mt19937& rng) {
+
+    vector<coord> p, got;
+    hullScratch scratch;
+    for(int round=0; round<3000; round++) {
+
+        simplePolygon(rng, round, p);
+        vector<coord> ref = bruteHull(p);
+
+        hullOptions opts;
+        opts.engine = MELKMAN_HULL;
+        opts.cull = round % 2;
+        computeHull(p.data(), p.size(), got, scratch, opts);
+        if( !sameHull(got, ref) ) {
+            printf("melkman differs on polygon kind %d, round %d, %zu vertices\n", round % 5, round,
+                p.size());
+            return false;
+        }
+
+    }
+
+    return true;
+
+}
+
+int main() {
+
+    threadPool pool(4);
+    hostDevice device(pool, 4096);
+
+    mt19937 rng(16);
+    vector<coord> pts;
+    for(int round=0; round<1500; round++) {
+
+        randomInput(rng, round, pts);
+        vector<coord> ref = bruteHull(pts);
+
+        const char* failed = NULL;
+        if( !allEngines(pts, ref, pool, device, failed) ) {
+            printf("%s differs from brute force on input kind %d, round %d, %zu points\n", failed,
+                round % 6, round, pts.size());
+            return 1;
+        }
+        if( !sortsIdentical(pts, pool) ) {
+            printf("angle sorts not identical on input kind %d, round %d\n", round % 6, round);
+            return 1;
+        }
+
+    }
+
+    if( !melkmanPolygons(rng) ) {
+        return 1;
+    }
+
+    printf("ok\n");
+    return 0;
+
+}
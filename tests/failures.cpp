@@ -0,0 +1,154 @@
+// a pool task that throws: with the pool's arenas refusing blocks, every threaded path must
+// hand bad_alloc to its caller instead of terminating, and the same pool must give the right
+// hulls again once blocks are granted
+
+#define main hullMain
+#include "../convex hull.cpp"
+#undef main
+
+/*the heap while granting, bad_alloc for every block while refusing*/
+class switchedSource : public blockSource {
+
+public:
+
+    switchedSource() : refusing(false) {}
+
+    void* allocate(size_t bytes) {
+
+        if( refusing ) {
+            throw bad_alloc();
+        }
+        return heap.allocate(bytes);
+
+    }
+
+    void deallocate(void* block, size_t bytes) {
+
+        heap.deallocate(block, bytes);
+
+    }
+
+    atomic<bool> refusing;
+
+private:
+
+    heapSource heap;
+
+};
+
+bool sameHull(const vector<coord>& a, const vector<coord>& b) {
+
+    if( a.size() != b.size() ) {
+        return false;
+    }
+    for(size_t i=0; i<a.size(); i++) {
+        if( a[i].x != b[i].x || a[i].y != b[i].y ) {
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+/*the threaded variants of one call: chunk hulls on the pool, QuickHull's own tasks, the device
+  blocks, and computeHulls spreading sets over the pool*/
+hullOptions variant(int v, threadPool& pool, hostDevice& device) {
+
+    hullOptions opts;
+    opts.pool = &pool;
+    if( v == 1 ) {
+        opts.engine = QUICK_HULL;
+    }
+    if( v == 2 ) {
+        opts.engine = MONOTONE_CHAIN;
+        opts.cull = true;
+    }
+    if( v == 3 ) {
+        opts.device = &device;
+        opts.offloadMin = 0;
+    }
+    return opts;
+
+}
+
+const int variants = 5;
+
+/*v < 4 is one computeHull call, v == 4 computeHulls over 64 slices of the points*/
+void runVariant(int v, const vector<coord>& pts, threadPool& pool, hostDevice& device,
+    vector<coord>& out) {
+
+    hullScratch scratch;
+    if( v < 4 ) {
+        computeHull(pts.data(), pts.size(), out, scratch, variant(v, pool, device));
+        return;
+    }
+
+    vector<size_t> offsets;
+    for(size_t s=0; s<=64; s++) {
+        offsets.push_back(pts.size() / 64 * s);
+    }
+    vector<size_t> hullOffsets;
+    computeHulls(pts.data(), offsets.data(), 64, out, hullOffsets, scratch, variant(0, pool, device));
+
+}
+
+int main() {
+
+    vector<coord> pts;
+    generatePoints(UNIFORM_DISK, 400000, 7, pts);
+
+    // the caller's arena is built on the heap now, so only the pool's threads meet the switch
+    vector<coord> ref;
+    computeHull(pts.data(), pts.size(), ref, MONOTONE_CHAIN);
+
+    static switchedSource source;
+    defaultBlockSource() = &source;
+
+    vector<vector<coord>> expected(variants);
+    {
+        threadPool pool(3);
+        hostDevice device(pool, (size_t)1 << 16);
+        for(int v=0; v<variants; v++) {
+            runVariant(v, pts, pool, device, expected[v]);
+        }
+    }
+    if( !sameHull(expected[0], ref) ) {
+        printf("pooled hull differs from the serial one\n");
+        return 1;
+    }
+
+    // arenas keep the blocks they got, so each round starts a pool whose threads have none yet
+    for(int round=0; round<20; round++) {
+
+        int v = round % variants;
+        threadPool pool(3);
+        hostDevice device(pool, (size_t)1 << 16);
+
+        vector<coord> out;
+        source.refusing = true;
+        bool thrown = false;
+        try {
+            runVariant(v, pts, pool, device, out);
+        }
+        catch(const bad_alloc&) {
+            thrown = true;
+        }
+        source.refusing = false;
+        if( !thrown ) {
+            printf("variant %d did not report the refused blocks\n", v);
+            return 1;
+        }
+
+        runVariant(v, pts, pool, device, out);
+        if( !sameHull(out, expected[v]) ) {
+            printf("variant %d differs after a failed call\n", v);
+            return 1;
+        }
+
+    }
+
+    printf("ok\n");
+    return 0;
+
+}
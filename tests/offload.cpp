@@ -0,0 +1,151 @@
+// hullOptions::device against the plain CPU path: single calls of every size around the block
+// boundaries, and the batch paths, computeHulls on a pool and hullService, which must not share
+// the one device between sets running at once
+
+#define main hullMain
+#include "../convex hull.cpp"
+#undef main
+
+bool sameHull(const coord* a, size_t na, const vector<coord>& b) {
+
+    if( na != b.size() ) {
+        return false;
+    }
+    for(size_t i=0; i<na; i++) {
+        if( a[i].x != b[i].x || a[i].y != b[i].y ) {
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+/*the hull without device, pool or cull, the reference for every offloaded call*/
+vector<coord> cpuHull(const coord* pts, size_t n) {
+
+    vector<coord> ref;
+    computeHull(pts, n, ref, MONOTONE_CHAIN);
+    return ref;
+
+}
+
+/*one call at a time through the device, for no points, a few, and around multiples of the block,
+  with each engine that offloads and with and without a pool for the finishing pass*/
+bool singleCalls(threadPool& pool) {
+
+    hostDevice device(pool, 1000);
+    const hullEngine engines[] = {GRAHAM_SCAN, MONOTONE_CHAIN, CHAN_HULL, QUICK_HULL, AUTO_SELECT};
+    const size_t sizes[] = {0, 1, 2, 3, 999, 1000, 1001, 2000, 2500, 7777};
+
+    mt19937 rng(23);
+    for(size_t k=0; k<sizeof sizes / sizeof sizes[0]; k++) {
+
+        vector<coord> pts;
+        generatePoints((pointDistribution)(k % 6), sizes[k], k, pts);
+        vector<coord> ref = cpuHull(pts.data(), pts.size());
+
+        for(size_t e=0; e<sizeof engines / sizeof engines[0]; e++) {
+
+            hullOptions opts;
+            opts.engine = engines[e];
+            opts.device = &device;
+            opts.offloadMin = 0;
+            opts.pool = rng() % 2 ? &pool : NULL;
+            opts.cull = rng() % 2;
+
+            vector<coord> got;
+            hullScratch scratch;
+            computeHull(pts.data(), pts.size(), got, scratch, opts);
+            if( !sameHull(got.data(), got.size(), ref) ) {
+                printf("offloaded hull differs for %zu points, engine %d\n", sizes[k], (int)engines[e]);
+                return false;
+            }
+
+        }
+
+    }
+
+    return true;
+
+}
+
+/*sets of 20k points, each bigger than the device's block, through computeHulls on the pool*/
+bool pooledBatches(threadPool& pool) {
+
+    hostDevice device(pool, 4096);
+    for(int round=0; round<4; round++) {
+
+        vector<coord> pts;
+        vector<size_t> offsets(1, 0);
+        for(size_t s=0; s<16; s++) {
+            vector<coord> set;
+            generatePoints((pointDistribution)(s % 6), 20000, round * 16 + s, set);
+            pts.insert(pts.end(), set.begin(), set.end());
+            offsets.push_back(pts.size());
+        }
+
+        hullOptions opts;
+        opts.pool = &pool;
+        opts.device = &device;
+        opts.offloadMin = 0;
+
+        vector<coord> hulls;
+        vector<size_t> hullOffsets;
+        hullScratch scratch;
+        computeHulls(pts.data(), offsets.data(), 16, hulls, hullOffsets, scratch, opts);
+        for(size_t s=0; s<16; s++) {
+            vector<coord> ref = cpuHull(pts.data() + offsets[s], offsets[s + 1] - offsets[s]);
+            if( !sameHull(hulls.data() + hullOffsets[s], hullOffsets[s + 1] - hullOffsets[s], ref) ) {
+                printf("computeHulls with pool and device differs for set %zu in round %d\n", s, round);
+                return false;
+            }
+        }
+
+    }
+
+    return true;
+
+}
+
+/*a service whose batches would reach the device, offloadMin below smallMax*/
+bool serviceBatches(threadPool& pool) {
+
+    hostDevice device(pool, 512);
+    hullOptions opts;
+    opts.device = &device;
+    opts.offloadMin = 0;
+
+    vector<vector<coord>> sets(200);
+    vector<future<vector<coord>>> results(sets.size());
+    {
+        hullService service(pool, opts, 4000, 20000);
+        for(size_t r=0; r<sets.size(); r++) {
+            generatePoints((pointDistribution)(r % 6), 1000 + r * 13, r, sets[r]);
+            results[r] = service.submit(sets[r].data(), sets[r].size());
+        }
+    }
+
+    for(size_t r=0; r<sets.size(); r++) {
+        vector<coord> got = results[r].get();
+        if( !sameHull(got.data(), got.size(), cpuHull(sets[r].data(), sets[r].size())) ) {
+            printf("service batch with a device differs for request %zu\n", r);
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+int main() {
+
+    threadPool pool(4);
+    if( !singleCalls(pool) || !pooledBatches(pool) || !serviceBatches(pool) ) {
+        return 1;
+    }
+
+    printf("ok\n");
+    return 0;
+
+}
@@ -0,0 +1,263 @@
+// hullQuery against brute force over the hull's edges: containment of vertices, points on the
+// edges and on their extensions, random points near and far, one point at a time and in batches,
+// on hulls of one point, of one segment and full polygons; extreme() for the axis directions,
+// the edge normals where two vertices tie, and random directions over the full range
+
+#define main hullMain
+#include "../convex hull.cpp"
+#undef main
+
+/*inside or on the boundary, checked against every edge, or against the point or segment*/
+bool bruteContains(const vector<coord>& h, coord p) {
+
+    if( h.size() == 1 ) {
+        return p.x == h[0].x && p.y == h[0].y;
+    }
+    if( h.size() == 2 ) {
+        const coord& a = h[0];
+        const coord& b = h[1];
+        return predicate<int>::orient(a.x, a.y, b.x, b.y, p.x, p.y) == 0 &&
+            min(a.x, b.x) <= p.x && p.x <= max(a.x, b.x) && min(a.y, b.y) <= p.y && p.y <= max(a.y, b.y);
+    }
+    for(size_t i=0; i<h.size(); i++) {
+        const coord& u = h[i];
+        const coord& w = h[i + 1 < h.size() ? i + 1 : 0];
+        if( predicate<int>::orient(u.x, u.y, w.x, w.y, p.x, p.y) < 0 ) {
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+__int128 dot(const coord& c, long long dx, long long dy) {
+
+    return (__int128)dx * c.x + (__int128)dy * c.y;
+
+}
+
+long long gcd(long long a, long long b) {
+
+    a = a < 0 ? -a : a;
+    b = b < 0 ? -b : b;
+    while(b != 0) {
+        long long t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+
+}
+
+coord point(long long x, long long y) {
+
+    coord c = coord();
+    c.x = (int)x;
+    c.y = (int)y;
+    return c;
+
+}
+
+bool inRange(long long x, long long y) {
+
+    return -maxCoordinate <= x && x <= maxCoordinate && -maxCoordinate <= y && y <= maxCoordinate;
+
+}
+
+/*a point set whose hull is one point, one segment (often axis-aligned), or a polygon, in a small
+  grid or over the full range*/
+vector<coord> inputSet(mt19937& rng, int round) {
+
+    long long range = round % 3 == 0 ? maxCoordinate : (long long)(rng() % 20 + 2);
+    uniform_int_distribution<long long> pick(-range, range);
+    size_t n = rng() % (round % 10 == 0 ? 2000 : 30) + 1;
+
+    vector<coord> pts;
+    int kind = round % 4;
+    coord a = point(pick(rng), pick(rng));
+    if( kind == 0 ) {
+        pts.assign(n, a);
+        return pts;
+    }
+    if( kind == 1 ) {
+
+        // points spaced along a primitive step from a, kept in range
+        int axis = rng() % 3;
+        long long sx = axis == 1 ? 0 : (long long)(rng() % 5) - 2;
+        long long sy = axis == 0 ? 0 : (long long)(rng() % 5) - 2;
+        if( sx == 0 && sy == 0 ) {
+            sx = 1;
+        }
+        long long steps = range == maxCoordinate ? 1000000 : 8;
+        for(size_t i=0; i<n; i++) {
+            long long k = (long long)(rng() % (steps + 1));
+            if( inRange(a.x + k * sx, a.y + k * sy) ) {
+                pts.push_back(point(a.x + k * sx, a.y + k * sy));
+            }
+        }
+        pts.push_back(a);
+        return pts;
+
+    }
+    for(size_t i=0; i<n; i++) {
+        pts.push_back(point(pick(rng), pick(rng)));
+    }
+    return pts;
+
+}
+
+/*the points to classify: every vertex, lattice points on every edge and one step beyond its
+  ends, and random points around the hull's box*/
+vector<coord> probes(mt19937& rng, const vector<coord>& h) {
+
+    vector<coord> out;
+    long long x0 = h[0].x, x1 = h[0].x, y0 = h[0].y, y1 = h[0].y;
+    for(size_t i=0; i<h.size(); i++) {
+
+        const coord& u = h[i];
+        const coord& w = h[i + 1 < h.size() ? i + 1 : 0];
+        x0 = min(x0, (long long)u.x);
+        x1 = max(x1, (long long)u.x);
+        y0 = min(y0, (long long)u.y);
+        y1 = max(y1, (long long)u.y);
+        out.push_back(u);
+        if( h.size() == 1 ) {
+            continue;
+        }
+
+        long long dx = (long long)w.x - u.x, dy = (long long)w.y - u.y;
+        long long g = gcd(dx, dy);
+        long long sx = dx / g, sy = dy / g;
+        for(int k=0; k<4; k++) {
+            long long t = (long long)(rng() % (g + 1));
+            out.push_back(point(u.x + t * sx, u.y + t * sy));
+        }
+        if( inRange(u.x - sx, u.y - sy) ) {
+            out.push_back(point(u.x - sx, u.y - sy));
+        }
+        if( inRange(w.x + sx, w.y + sy) ) {
+            out.push_back(point(w.x + sx, w.y + sy));
+        }
+
+    }
+
+    long long pad = 2;
+    uniform_int_distribution<long long> px(max(x0 - pad, -maxCoordinate), min(x1 + pad, maxCoordinate));
+    uniform_int_distribution<long long> py(max(y0 - pad, -maxCoordinate), min(y1 + pad, maxCoordinate));
+    for(int k=0; k<200; k++) {
+        out.push_back(point(px(rng), py(rng)));
+    }
+    return out;
+
+}
+
+bool checkContains(mt19937& rng, const vector<coord>& h, const hullQuery& q, int round) {
+
+    vector<coord> p = probes(rng, h);
+    vector<int> x(p.size()), y(p.size());
+    for(size_t i=0; i<p.size(); i++) {
+        x[i] = p[i].x;
+        y[i] = p[i].y;
+    }
+    vector<unsigned char> inside(p.size());
+    q.contains(x.data(), y.data(), p.size(), inside.data());
+
+    for(size_t i=0; i<p.size(); i++) {
+        bool ref = bruteContains(h, p[i]);
+        if( q.contains(p[i]) != ref || (bool)inside[i] != ref ) {
+            printf("contains(%d, %d) wrong on a hull of %zu in round %d: %d single, %d batched\n", p[i].x,
+                p[i].y, h.size(), round, (int)q.contains(p[i]), (int)inside[i]);
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+/*a vertex of largest dot product, and on a polygon the first of two tied vertices
+  counter-clockwise, whose predecessor falls short*/
+bool checkExtreme(const vector<coord>& h, const hullQuery& q, long long dx, long long dy, int round) {
+
+    size_t n = h.size();
+    size_t e = q.extreme(dx, dy);
+    __int128 best = dot(h[0], dx, dy);
+    for(size_t i=1; i<n; i++) {
+        best = max(best, dot(h[i], dx, dy));
+    }
+
+    bool first = true;
+    if( n >= 3 && (dx != 0 || dy != 0) ) {
+        first = dot(h[e == 0 ? n - 1 : e - 1], dx, dy) < best;
+    }
+    if( e >= n || dot(h[e], dx, dy) != best || !first ) {
+        printf("extreme(%lld, %lld) gave vertex %zu of %zu in round %d\n", dx, dy, e, n, round);
+        return false;
+    }
+
+    return true;
+
+}
+
+bool checkExtremes(mt19937& rng, const vector<coord>& h, const hullQuery& q, int round) {
+
+    const long long axes[][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {0, 0}, {1000, 0}, {0, -1000}};
+    for(size_t k=0; k<sizeof axes / sizeof axes[0]; k++) {
+        if( !checkExtreme(h, q, axes[k][0], axes[k][1], round) ) {
+            return false;
+        }
+    }
+
+    // each edge's outward normal, where its two ends tie
+    for(size_t i=0; i<h.size() && h.size() >= 2; i++) {
+        const coord& u = h[i];
+        const coord& w = h[i + 1 < h.size() ? i + 1 : 0];
+        if( !checkExtreme(h, q, (long long)w.y - u.y, (long long)u.x - w.x, round) ) {
+            return false;
+        }
+    }
+
+    uniform_int_distribution<long long> small(-1000, 1000);
+    uniform_int_distribution<long long> full(-(1ll << 31), 1ll << 31);
+    for(int k=0; k<100; k++) {
+        long long dx = k % 2 ? full(rng) : small(rng);
+        long long dy = k % 2 ? full(rng) : small(rng);
+        if( !checkExtreme(h, q, dx, dy, round) ) {
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+int main() {
+
+    mt19937 rng(26);
+    size_t shapes[4] = {0, 0, 0, 0};
+    for(int round=0; round<4000; round++) {
+
+        vector<coord> pts = inputSet(rng, round);
+        vector<coord> h;
+        computeHull(pts.data(), pts.size(), h, MONOTONE_CHAIN);
+        hullQuery q(h);
+        shapes[min(h.size(), (size_t)3)]++;
+
+        if( !checkContains(rng, h, q, round) || !checkExtremes(rng, h, q, round) ) {
+            return 1;
+        }
+
+    }
+
+    // every kind of hull must have come up
+    if( shapes[1] == 0 || shapes[2] == 0 || shapes[3] == 0 ) {
+        printf("hull shapes not all covered: %zu points, %zu segments, %zu polygons\n", shapes[1], shapes[2],
+            shapes[3]);
+        return 1;
+    }
+
+    printf("ok\n");
+    return 0;
+
+}
@@ -0,0 +1,223 @@
+// hullService against computeHull with the same options for every engine, Melkman on simple
+// polygons, from several submitting threads, and a failing block source to see that a stage's
+// exception reaches the request's future; meant to run under ASan and TSan as well
+// (make -C tests sanitize)
+
+#define main hullMain
+#include "../convex hull.cpp"
+#undef main
+
+bool sameHull(const vector<coord>& a, const vector<coord>& b) {
+
+    if( a.size() != b.size() ) {
+        return false;
+    }
+    for(size_t i=0; i<a.size(); i++) {
+        if( a[i].x != b[i].x || a[i].y != b[i].y ) {
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+/*mostly small sets for the batches, every tenth one big enough for the staged path*/
+void requestSets(vector<vector<coord>>& sets) {
+
+    mt19937 rng(8);
+    for(size_t r=0; r<sets.size(); r++) {
+        size_t n = r % 10 == 0 ? 5000 + rng() % 20000 : rng() % 300;
+        generatePoints((pointDistribution)(r % 6), n, r, sets[r]);
+    }
+
+}
+
+/*star-shaped simple polygons for Melkman, vertices in angle order at radii far apart enough
+  on the lattice that rounding keeps them so, started anywhere*/
+void polygonSets(vector<vector<coord>>& sets) {
+
+    mt19937 rng(9);
+    uniform_real_distribution<double> radius(1 << 20, 1 << 29);
+    for(size_t r=0; r<sets.size(); r++) {
+
+        size_t n = r % 10 == 0 ? 5000 + rng() % 20000 : rng() % 300;
+        size_t start = n == 0 ? 0 : rng() % n;
+        sets[r].resize(n);
+        for(size_t i=0; i<n; i++) {
+            double a = 2 * M_PI * (double)((i + start) % n) / (double)n, d = radius(rng);
+            sets[r][i] = coord();
+            sets[r][i].x = (int)lround(d * cos(a));
+            sets[r][i].y = (int)lround(d * sin(a));
+        }
+
+    }
+
+}
+
+/*odd requests move a copy in, even ones lend the buffer; three threads submit at once*/
+void submitAll(hullService& service, const vector<vector<coord>>& sets,
+    vector<future<vector<coord>>>& results) {
+
+    vector<thread> submitters;
+    for(size_t t=0; t<3; t++) {
+        submitters.emplace_back([&, t]{
+            for(size_t r=t; r<sets.size(); r+=3) {
+                if( r % 2 ) {
+                    vector<coord> copy = sets[r];
+                    results[r] = service.submit(move(copy));
+                }
+                else {
+                    results[r] = service.submit(sets[r].data(), sets[r].size());
+                }
+            }
+        });
+    }
+    for(size_t t=0; t<submitters.size(); t++) {
+        submitters[t].join();
+    }
+
+}
+
+/*every engine, sort and cull setting the service handles, and the cache with a second round
+  of lookups that must come back from it; Melkman gets the polygons*/
+bool matchesComputeHull(const vector<vector<coord>>& points, const vector<vector<coord>>& polygons) {
+
+    hullCache cache((size_t)1 << 22);
+    const int variantCount = 9;
+    hullOptions variants[variantCount];
+    variants[1].engine = MONOTONE_CHAIN;
+    variants[2].engine = QUICK_HULL;
+    variants[3].engine = CHAN_HULL;
+    variants[4].engine = AUTO_SELECT;
+    variants[5].engine = MELKMAN_HULL;
+    variants[6].cull = true;
+    variants[7].cache = &cache;
+    variants[8].sort = DELTA_SORT;
+
+    for(int v=0; v<variantCount; v++) {
+
+        const vector<vector<coord>>& sets = variants[v].engine == MELKMAN_HULL ? polygons : points;
+        threadPool pool(3);
+        vector<future<vector<coord>>> results(sets.size());
+        {
+            hullService service(pool, variants[v], 1000, 4000);
+            submitAll(service, sets, results);
+
+            if( variants[v].cache != NULL ) {
+                for(size_t r=0; r<sets.size(); r++) {
+                    results[r].wait();
+                }
+                for(size_t r=0; r<sets.size(); r+=7) {
+                    vector<coord> hit = service.submit(sets[r].data(), sets[r].size()).get(), ref;
+                    computeHull(sets[r].data(), sets[r].size(), ref);
+                    if( !sameHull(hit, ref) ) {
+                        printf("cached hull differs for request %zu\n", r);
+                        return false;
+                    }
+                }
+            }
+        }
+
+        hullOptions plain = variants[v];
+        plain.cache = NULL;
+        for(size_t r=0; r<sets.size(); r++) {
+            vector<coord> got = results[r].get(), ref;
+            hullScratch scratch;
+            computeHull(sets[r].data(), sets[r].size(), ref, scratch, plain);
+            if( !sameHull(got, ref) ) {
+                printf("variant %d differs from computeHull for request %zu\n", v, r);
+                return false;
+            }
+            // on a simple polygon Melkman's hull is the one the other engines give
+            if( variants[v].engine == MELKMAN_HULL ) {
+                computeHull(sets[r].data(), sets[r].size(), ref, MONOTONE_CHAIN);
+                if( !sameHull(got, ref) ) {
+                    printf("melkman through the service is no hull for request %zu\n", r);
+                    return false;
+                }
+            }
+        }
+
+    }
+
+    return true;
+
+}
+
+/*refuses every block, so any stage that needs arena scratch throws bad_alloc*/
+class failingSource : public blockSource {
+
+public:
+
+    void* allocate(size_t) {
+
+        throw bad_alloc();
+
+    }
+
+    void deallocate(void*, size_t) {}
+
+};
+
+/*with the pool's arenas on a failing source, every request either fails with bad_alloc on
+  its future or, when it needed no scratch, still has the right hull; the destructor must not
+  wait on the failed ones*/
+bool failuresReachFutures(const vector<vector<coord>>& sets) {
+
+    static failingSource failing;
+    blockSource* heap = defaultBlockSource();
+    defaultBlockSource() = &failing;
+
+    size_t failedSmall = 0, failedBig = 0;
+    bool ok = true;
+    {
+        // a fresh pool, so its threads' arenas are built on the failing source
+        threadPool pool(2);
+        vector<future<vector<coord>>> results(sets.size());
+        {
+            // the Graham stages keep their buffers in the request, the monotone chain's sort
+            // takes arena scratch in both the batched and the staged path
+            hullOptions opts;
+            opts.engine = MONOTONE_CHAIN;
+            hullService service(pool, opts, 1000, 4000);
+            submitAll(service, sets, results);
+        }
+
+        defaultBlockSource() = heap;
+        for(size_t r=0; r<sets.size() && ok; r++) {
+            try {
+                vector<coord> got = results[r].get(), ref;
+                computeHull(sets[r].data(), sets[r].size(), ref, MONOTONE_CHAIN);
+                ok = sameHull(got, ref);
+            }
+            catch(const bad_alloc&) {
+                (sets[r].size() > 1000 ? failedBig : failedSmall)++;
+            }
+        }
+    }
+
+    if( !ok || failedSmall == 0 || failedBig == 0 ) {
+        printf("failing source: %zu batched and %zu staged requests failed%s\n", failedSmall,
+            failedBig, ok ? "" : ", and a hull that came back differs");
+        return false;
+    }
+
+    return true;
+
+}
+
+int main() {
+
+    vector<vector<coord>> sets(1500), polygons(1500);
+    requestSets(sets);
+    polygonSets(polygons);
+
+    if( !matchesComputeHull(sets, polygons) || !failuresReachFutures(sets) ) {
+        return 1;
+    }
+
+    printf("ok\n");
+    return 0;
+
+}
@@ -0,0 +1,196 @@
+// the SIMD kernels against the scalar ones on random inputs: every kernel set the CPU runs
+// must give bit-identical results, so a failure names the set and the kernel
+
+#define main hullMain
+#include "../convex hull.cpp"
+#undef main
+
+/*the kernel sets this machine can run, the scalar reference first*/
+vector<simdKernels> kernelSets() {
+
+    vector<simdKernels> sets;
+    sets.push_back({findStartScalar, storeAngleScalar, farthestScalar, insideFanScalar,
+        hashStripesScalar, "scalar"});
+
+#ifdef HULL_X86_SIMD
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports("avx2") ) {
+        sets.push_back({findStartAvx2, storeAngleAvx2, farthestAvx2, insideFanAvx2,
+            hashStripesAvx2, "avx2"});
+    }
+    if( __builtin_cpu_supports("avx512f") ) {
+        sets.push_back({findStartAvx512, storeAngleAvx512, farthestAvx512, insideFanAvx512,
+            hashStripesAvx512, "avx512"});
+    }
+#endif
+#ifdef HULL_NEON_SIMD
+    sets.push_back(pickKernels());
+#endif
+
+    return sets;
+
+}
+
+/*n points on a small grid, so ties in x, y and angle are common, or over the full range*/
+void randomPoints(mt19937& rng, size_t n, bool full, vector<int>& x, vector<int>& y) {
+
+    int range = full ? (int)maxCoordinate : (int)(rng() % 60 + 1);
+    uniform_int_distribution<int> pick(-range, range);
+    x.resize(n);
+    y.resize(n);
+    for(size_t i=0; i<n; i++) {
+        x[i] = pick(rng);
+        y[i] = pick(rng);
+    }
+
+}
+
+bool fail(const char* set, const char* kernel, int round) {
+
+    printf("%s %s differs from scalar in round %d\n", set, kernel, round);
+    return false;
+
+}
+
+/*findStart, storeAngle and farthest on one random input*/
+bool pointKernels(const vector<simdKernels>& sets, mt19937& rng, int round) {
+
+    vector<int> x, y;
+    size_t n = rng() % 400 + 1;
+    randomPoints(rng, n, round % 4 == 0, x, y);
+
+    const simdKernels& ref = sets[0];
+    size_t start = ref.findStart(x.data(), y.data(), n);
+    vector<coord> angles(n), got(n);
+    ref.storeAngle(x.data(), y.data(), n, x[start], y[start], angles.data());
+
+    size_t a = rng() % n, b = rng() % n;
+    size_t far = ref.farthest(x.data(), y.data(), n, x[a], y[a], x[b], y[b]);
+
+    for(size_t s=1; s<sets.size(); s++) {
+
+        if( sets[s].findStart(x.data(), y.data(), n) != start ) {
+            return fail(sets[s].name, "findStart", round);
+        }
+
+        sets[s].storeAngle(x.data(), y.data(), n, x[start], y[start], got.data());
+        if( memcmp(got.data(), angles.data(), n * sizeof(coord)) != 0 ) {
+            return fail(sets[s].name, "storeAngle", round);
+        }
+
+        if( sets[s].farthest(x.data(), y.data(), n, x[a], y[a], x[b], y[b]) != far ) {
+            return fail(sets[s].name, "farthest", round);
+        }
+
+    }
+
+    return true;
+
+}
+
+/*insideFan on points around a random hull, many of them on its boundary*/
+bool fanKernel(const vector<simdKernels>& sets, mt19937& rng, int round) {
+
+    vector<int> x, y;
+    size_t n = rng() % 2000 + 3;
+    randomPoints(rng, n, round % 4 == 0, x, y);
+
+    vector<coord> pts(n), h;
+    for(size_t i=0; i<n; i++) {
+        pts[i] = coord();
+        pts[i].x = x[i];
+        pts[i].y = y[i];
+    }
+    computeHull(pts.data(), n, h, MONOTONE_CHAIN);
+    if( h.size() < 3 ) {
+        return true;
+    }
+
+    vector<int> xy(2 * h.size());
+    vector<long long> fanBias(h.size()), edgeBias(h.size());
+    for(size_t i=0; i<h.size(); i++) {
+        const coord& next = h[(i + 1) % h.size()];
+        xy[2 * i] = h[i].x;
+        xy[2 * i + 1] = h[i].y;
+        fanBias[i] = farthestBias(h[0].x, h[0].y, h[i].x, h[i].y);
+        edgeBias[i] = farthestBias(h[i].x, h[i].y, next.x, next.y);
+    }
+    fanTable fan = {xy.data(), fanBias.data(), edgeBias.data(), h.size()};
+
+    // test points: the input itself, hull vertices and fresh random points
+    size_t m = n + rng() % 50;
+    vector<int> tx(x), ty(y);
+    randomPoints(rng, m - n, round % 4 == 0, x, y);
+    tx.insert(tx.end(), x.begin(), x.end());
+    ty.insert(ty.end(), y.begin(), y.end());
+    for(size_t i=0; i<m; i+=5) {
+        const coord& v = h[rng() % h.size()];
+        tx[i] = v.x;
+        ty[i] = v.y;
+    }
+
+    vector<unsigned char> inside(m), got(m);
+    sets[0].insideFan(fan, tx.data(), ty.data(), m, inside.data());
+    for(size_t s=1; s<sets.size(); s++) {
+        sets[s].insideFan(fan, tx.data(), ty.data(), m, got.data());
+        if( got != inside ) {
+            return fail(sets[s].name, "insideFan", round);
+        }
+    }
+
+    return true;
+
+}
+
+/*hashStripes from the same starting lanes*/
+bool hashKernel(const vector<simdKernels>& sets, mt19937& rng, int round) {
+
+    size_t stripes = rng() % (2 * hashBlockStripes + 3);
+    vector<int> x, y;
+    randomPoints(rng, 8 * stripes, round % 2 == 0, x, y);
+    vector<coord> pts(8 * stripes);
+    for(size_t i=0; i<pts.size(); i++) {
+        pts[i] = coord();
+        pts[i].x = x[i];
+        pts[i].y = y[i];
+    }
+
+    unsigned long long seed[8], lanes[8], got[8];
+    for(int j=0; j<8; j++) {
+        seed[j] = ((unsigned long long)rng() << 32) | rng();
+    }
+
+    memcpy(lanes, seed, sizeof lanes);
+    sets[0].hashStripes(pts.data(), stripes, lanes);
+    for(size_t s=1; s<sets.size(); s++) {
+        memcpy(got, seed, sizeof got);
+        sets[s].hashStripes(pts.data(), stripes, got);
+        if( memcmp(got, lanes, sizeof got) != 0 ) {
+            return fail(sets[s].name, "hashStripes", round);
+        }
+    }
+
+    return true;
+
+}
+
+int main() {
+
+    vector<simdKernels> sets = kernelSets();
+    for(size_t s=0; s<sets.size(); s++) {
+        printf("%s%s", s ? ", " : "kernels: ", sets[s].name);
+    }
+    printf("\n");
+
+    mt19937 rng(4);
+    for(int round=0; round<3000; round++) {
+        if( !pointKernels(sets, rng, round) || !fanKernel(sets, rng, round) ||
+            !hashKernel(sets, rng, round) ) {
+            return 1;
+        }
+    }
+
+    printf("ok\n");
+    return 0;
+
+}